@@ -252,16 +252,26 @@ vector<int> Graph::getOrdering() {
 }
 
 Graph Graph::readFromSTDIN() {
-    int n, m;
-    cin >> n >> m;
+    GraphParser parser(cin);
+    if (!parser.skipBlankLines()) {
+        throw parse_exception(parser.line(), "missing vertex and edge counts");
+    }
+    int n = parser.readInteger<int>("vertex count");
+    int m = parser.readInteger<int>("edge count");
+    parser.endLine();
 
     Graph g;
+    delete[] g.adjacencyList;
     g.adjacencyList = new vector<int>[n];
     g.listSize = n;
 
     for (int i = 0; i < m; i++) {
-        int u, v;
-        cin >> u >> v;
+        if (!parser.skipBlankLines()) {
+            throw parse_exception(parser.line(), "expected " + to_string(m) + " edges, found " + to_string(i));
+        }
+        int u = parser.readInteger<int>("edge start");
+        int v = parser.readInteger<int>("edge end");
+        parser.endLine();
         g.addEdge(u, v);
     }
 
@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <queue>
 #include "customexceptions.hpp"
+#include "graphParser.hpp"
 using namespace std;
 
 class Graph {
@@ -0,0 +1,146 @@
+//=========================================================
+// CompressedGraph.cpp
+// Andrew McCutchan, Namu Kim
+// Implementaiton file for CompressedGraph class
+// 12/18/2024
+//=========================================================
+
+#include "compressedGraph.hpp"
+
+//==============================================================
+// Constructor
+// INPUTS: Frozen graph, weight format, step for FIXED_WEIGHTS
+// OUTPUTS: NONE
+// Encodes every out-edge of the graph, keeping its dense indices.
+// Fixed point weights are rounded to the nearest multiple of step,
+// so they are off by at most step / 2; floats are off by at most
+// about 6e-8 of the weight. The largest error actually made is
+// kept for maxWeightError() and maxRelativeError(). Gaps between
+// neighbors are smaller when neighbors have close indices, as after
+// WeightedGraph::setNodeOrder(HILBERT_ORDER).
+//==============================================================
+template <class T>
+CompressedGraph<T>::CompressedGraph(const CSRGraph<T>& graph, WeightFormat format, double step) {
+    if (format == FIXED_WEIGHTS && (!(step > 0) || isinf(step))) {
+        throw invalid_argument("Fixed point step must be positive");
+    }
+    int n = graph.numNodes();
+    this->format = format;
+    this->step = format == FIXED_WEIGHTS ? step : 0;
+    edgeCount = graph.numEdges();
+    maxError = 0;
+    maxRelError = 0;
+    ids.resize(n);
+    offsets.resize(n + 1);
+    stream.reserve(graph.numEdges() * (format == FIXED_WEIGHTS ? 4 : 6));
+
+    for (int u = 0; u < n; u++) {
+        ids[u] = graph.nodeId(u);
+        if (stream.size() > numeric_limits<uint32_t>::max()) {
+            throw runtime_error("Compressed edge stream is over 4 GB");
+        }
+        offsets[u] = stream.size();
+
+        long long previous = u;
+        for (int e = graph.edgeBegin(u); e < graph.edgeEnd(u); e++) {
+            long long v = graph.target(e);
+            if (e == graph.edgeBegin(u)) {
+                long long delta = v - u;
+                putVarint(stream, (static_cast<uint64_t>(delta) << 1) ^ static_cast<uint64_t>(delta >> 63));
+            }
+            else {
+                putVarint(stream, v - previous);
+            }
+            previous = v;
+
+            double w = graph.weight(e);
+            double stored;
+            if (format == FIXED_WEIGHTS) {
+                double units = round(w / step);
+                if (!(units >= 0) || units > 9007199254740992.0) {
+                    throw invalid_argument("Fixed point weights must be non-negative and below 2^53 steps");
+                }
+                putVarint(stream, static_cast<uint64_t>(units));
+                stored = units * step;
+            }
+            else {
+                float f = static_cast<float>(w);
+                if (isinf(f) && !isinf(w)) {
+                    throw invalid_argument("Weight too large for a 32-bit float");
+                }
+                uint8_t bytes[sizeof(f)];
+                memcpy(bytes, &f, sizeof(f));
+                stream.insert(stream.end(), bytes, bytes + sizeof(f));
+                stored = f;
+            }
+            double error = fabs(stored - w);
+            maxError = max(maxError, error);
+            if (w != 0) {
+                maxRelError = max(maxRelError, error / fabs(w));
+            }
+        }
+    }
+    if (stream.size() > numeric_limits<uint32_t>::max()) {
+        throw runtime_error("Compressed edge stream is over 4 GB");
+    }
+    offsets[n] = stream.size();
+    stream.shrink_to_fit();
+}
+
+//==============================================================
+// putVarint
+// INPUTS: Byte stream, value to append
+// OUTPUTS: NONE
+// Appends the value 7 bits at a time, low bits first, with the top
+// bit of each byte set while more bytes follow
+//==============================================================
+template <class T>
+void CompressedGraph<T>::putVarint(vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value) | 0x80);
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+//==============================================================
+// dijkstras
+// INPUTS: Dense source and target indices, workspace to search in
+// OUTPUTS: Weight of the shortest path, infinity if unreachable
+// The same lazy Dijkstra as CSRGraph::dijkstras, decoding each
+// node's edges as it is settled. The path can be read from the
+// workspace. Distances use the stored weights, so they can differ
+// from the original graph by maxWeightError() per edge.
+//==============================================================
+template <class T>
+double CompressedGraph<T>::dijkstras(int source, int target, SearchWorkspace& ws) const {
+    ws.reset(numNodes());
+    ws.update(source, 0, -1);
+    ws.queue.insert(source, 0);
+
+    while (!ws.queue.isEmpty()) {
+        auto [current, currentDist] = ws.queue.extractMin();
+        ws.settled++;
+        if (current == target) {
+            return currentDist;
+        }
+
+        forEachEdge(current, [&](int neighbor, double weight) {
+            double newDist = currentDist + weight;
+            if (!ws.reached(neighbor)) {
+                ws.update(neighbor, newDist, current);
+                ws.queue.insert(neighbor, newDist);
+            }
+            else if (ws.distance(neighbor) > newDist) {
+                ws.update(neighbor, newDist, current);
+                ws.queue.decreaseKey(neighbor, newDist);
+            }
+        });
+    }
+    return numeric_limits<double>::infinity();
+}
+
+// class instantiations
+template class CompressedGraph<long>;
+template class CompressedGraph<long long>;
+template class CompressedGraph<int>;
@@ -0,0 +1,119 @@
+//=========================================================
+// CompressedGraph.hpp
+// Andrew McCutchan, Namu Kim
+// Header file containing all function delcarations for
+// CompressedGraph class. A read-only copy of a frozen graph
+// whose neighbor lists are delta and varint encoded into one
+// byte stream, with weights stored as 32-bit floats or fixed
+// point, small enough for maps that don't fit as a CSRGraph.
+// 12/18/2024
+//=========================================================
+
+#ifndef COMPRESSED_GRAPH_HPP
+#define COMPRESSED_GRAPH_HPP
+
+#include <vector>
+#include <limits>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <stdexcept>
+#include "csrGraph.hpp"
+#include "searchWorkspace.hpp"
+using namespace std;
+
+// how CompressedGraph stores edge weights
+enum WeightFormat {
+    FLOAT_WEIGHTS,      // 4 bytes each, rounded to the nearest float
+    FIXED_WEIGHTS       // whole multiples of a step, varint encoded
+};
+
+template <typename T>
+class CompressedGraph {
+    private:
+        // each node's edges are its targets in ascending order, the
+        // first as a zigzag varint of (target - node) and the rest as
+        // varint gaps from the previous one, each followed by its weight
+        vector<T>           ids;        // dense index -> node ID, as in the source graph
+        vector<uint32_t>    offsets;    // edges of u are stream[offsets[u], offsets[u + 1])
+        vector<uint8_t>     stream;
+        int                 edgeCount;
+        WeightFormat        format;
+        double              step;       // weight of one fixed point unit
+        double              maxError;   // largest |stored - original| over all weights
+        double              maxRelError; // largest |stored - original| / original
+
+        static void putVarint(vector<uint8_t>& out, uint64_t value);
+
+        static uint64_t getVarint(const uint8_t*& p) {
+            uint64_t value = *p++;
+            if (value < 0x80) {
+                return value;
+            }
+            value &= 0x7f;
+            for (int shift = 7; ; shift += 7) {
+                uint64_t byte = *p++;
+                value |= (byte & 0x7f) << shift;
+                if (byte < 0x80) {
+                    return value;
+                }
+            }
+        }
+
+        // decodes with the weight format fixed at compile time, so
+        // the loop doesn't test it for every edge
+        template <bool Fixed, typename F>
+        void decode(int u, F visit) const {
+            const uint8_t* p = stream.data() + offsets[u];
+            const uint8_t* end = stream.data() + offsets[u + 1];
+            if (p == end) {
+                return;
+            }
+            uint64_t zigzag = getVarint(p);
+            long long v = u + (static_cast<long long>(zigzag >> 1) ^ -static_cast<long long>(zigzag & 1));
+            while (true) {
+                double w;
+                if (Fixed) {
+                    w = getVarint(p) * step;
+                }
+                else {
+                    float f;
+                    memcpy(&f, p, sizeof(f));
+                    p += sizeof(f);
+                    w = f;
+                }
+                visit(static_cast<int>(v), w);
+                if (p == end) {
+                    return;
+                }
+                v += getVarint(p);
+            }
+        }
+
+    public:
+                    CompressedGraph(const CSRGraph<T>& graph, WeightFormat format = FLOAT_WEIGHTS, double step = 0.01);
+        double      dijkstras(int source, int target, SearchWorkspace& ws) const;
+
+        // calls visit(target, weight) for every out-edge of u
+        template <typename F>
+        void forEachEdge(int u, F visit) const {
+            if (format == FIXED_WEIGHTS) {
+                decode<true>(u, visit);
+            }
+            else {
+                decode<false>(u, visit);
+            }
+        }
+
+        // getter functions
+        int             numNodes() const { return ids.size(); }
+        int             numEdges() const { return edgeCount; }
+        T               nodeId(int u) const { return ids[u]; }
+        WeightFormat    weightFormat() const { return format; }
+        double          weightStep() const { return step; }
+        double          maxWeightError() const { return maxError; }
+        double          maxRelativeError() const { return maxRelError; }
+        size_t          edgeBytes() const { return offsets.size() * sizeof(uint32_t) + stream.size(); }
+};
+
+#endif
@@ -0,0 +1,389 @@
+//=========================================================
+// ContractionHierarchy.cpp
+// Andrew McCutchan, Namu Kim
+// Implementaiton file for ContractionHierarchy class
+// 12/18/2024
+//=========================================================
+
+#include "contractionHierarchy.hpp"
+
+// witness searches give up after settling this many nodes; giving up
+// early only costs an unnecessary shortcut, never a wrong answer. The
+// searches that only estimate a node's importance use a tighter limit.
+const int WITNESS_SETTLE_LIMIT = 500;
+const int SIMULATE_SETTLE_LIMIT = 50;
+
+//==============================================================
+// Default Constructor
+// INPUTS: NONE
+// OUTPUTS: NONE
+// Creates an empty hierarchy
+//==============================================================
+template <class T>
+ContractionHierarchy<T>::ContractionHierarchy() {
+    shortcuts = 0;
+    upOffsets.push_back(0);
+    downOffsets.push_back(0);
+}
+
+//==============================================================
+// Constructor
+// INPUTS: CSR graph to preprocess
+// OUTPUTS: NONE
+// Contracts every node in order of importance. The importance of
+// a node is the number of shortcuts contracting it would add,
+// minus the edges it removes, plus how many of its neighbors are
+// already contracted (to spread contraction evenly). Importances
+// are updated lazily: a node popped from the queue is re-scored
+// and pushed back if it is no longer the least important. Each
+// node's remaining edges at contraction time become the upward
+// and downward search graphs.
+//==============================================================
+template <class T>
+ContractionHierarchy<T>::ContractionHierarchy(const CSRGraph<T>& graph) {
+    int n = graph.numNodes();
+    vector<vector<Arc> > out(n), in(n);
+    for (int u = 0; u < n; u++) {
+        for (int e = graph.edgeBegin(u); e < graph.edgeEnd(u); e++) {
+            int v = graph.target(e);
+            if (u != v) {
+                out[u].push_back({v, graph.weight(e), -1});
+                in[v].push_back({u, graph.weight(e), -1});
+            }
+        }
+    }
+
+    vector<bool> contracted(n, false);
+    vector<int> contractedNeighbors(n, 0);
+    SearchWorkspace ws;
+    IndexedPriorityQueue<> order(n);
+    for (int v = 0; v < n; v++) {
+        int added = contractNode(v, out, in, contracted, ws, true);
+        order.insert(v, added - static_cast<int>(out[v].size() + in[v].size()));
+    }
+
+    // hierarchy edges as (node they are stored at, other end, weight, middle)
+    vector<pair<int, Arc> > upEdges, downEdges;
+    rank.assign(n, -1);
+    shortcuts = 0;
+    int nextRank = 0;
+
+    while (!order.isEmpty()) {
+        int v = order.extractMin().first;
+
+        int degree = 0;
+        for (const Arc& a : out[v]) {
+            degree += !contracted[a.node];
+        }
+        for (const Arc& a : in[v]) {
+            degree += !contracted[a.node];
+        }
+        int priority = contractNode(v, out, in, contracted, ws, true) - degree + contractedNeighbors[v];
+        if (!order.isEmpty() && priority > order.peekMin().second) {
+            order.insert(v, priority);
+            continue;
+        }
+
+        shortcuts += contractNode(v, out, in, contracted, ws, false);
+        contracted[v] = true;
+        rank[v] = nextRank++;
+
+        for (const Arc& a : out[v]) {
+            if (!contracted[a.node]) {
+                upEdges.push_back(make_pair(v, a));
+                contractedNeighbors[a.node]++;
+            }
+        }
+        for (const Arc& a : in[v]) {
+            if (!contracted[a.node]) {
+                downEdges.push_back(make_pair(v, a));
+                contractedNeighbors[a.node]++;
+            }
+        }
+    }
+
+    // lay both search graphs out in CSR form
+    upOffsets.assign(n + 1, 0);
+    downOffsets.assign(n + 1, 0);
+    for (const auto& [u, a] : upEdges) {
+        upOffsets[u + 1]++;
+    }
+    for (const auto& [v, a] : downEdges) {
+        downOffsets[v + 1]++;
+    }
+    for (int u = 0; u < n; u++) {
+        upOffsets[u + 1] += upOffsets[u];
+        downOffsets[u + 1] += downOffsets[u];
+    }
+
+    upTargets.resize(upEdges.size());
+    upWeights.resize(upEdges.size());
+    upMiddles.resize(upEdges.size());
+    vector<int> next(upOffsets.begin(), upOffsets.end() - 1);
+    for (const auto& [u, a] : upEdges) {
+        int slot = next[u]++;
+        upTargets[slot] = a.node;
+        upWeights[slot] = a.weight;
+        upMiddles[slot] = a.middle;
+    }
+
+    downSources.resize(downEdges.size());
+    downWeights.resize(downEdges.size());
+    downMiddles.resize(downEdges.size());
+    next.assign(downOffsets.begin(), downOffsets.end() - 1);
+    for (const auto& [v, a] : downEdges) {
+        int slot = next[v]++;
+        downSources[slot] = a.node;
+        downWeights[slot] = a.weight;
+        downMiddles[slot] = a.middle;
+    }
+}
+
+//==============================================================
+// contractNode
+// INPUTS: Node to contract, the graph being contracted, which
+//         nodes are already gone, a workspace for witness searches
+//         and whether to only count the shortcuts
+// OUTPUTS: Number of shortcuts needed to remove the node
+// For every remaining in-neighbor u and out-neighbor w of v, adds
+// a shortcut u -> w unless a witness search finds a path from u
+// to w that avoids v and is no longer than u -> v -> w.
+//==============================================================
+template <class T>
+int ContractionHierarchy<T>::contractNode(int v, vector<vector<Arc> >& out, vector<vector<Arc> >& in,
+                                          const vector<bool>& contracted, SearchWorkspace& ws, bool simulate) {
+    double maxOut = 0;
+    for (const Arc& a : out[v]) {
+        if (!contracted[a.node]) {
+            maxOut = max(maxOut, a.weight);
+        }
+    }
+
+    int added = 0;
+    for (size_t i = 0; i < in[v].size(); i++) {
+        Arc inArc = in[v][i];
+        int u = inArc.node;
+        if (contracted[u]) {
+            continue;
+        }
+
+        witnessSearch(u, v, inArc.weight + maxOut, out, contracted, ws,
+                      simulate ? SIMULATE_SETTLE_LIMIT : WITNESS_SETTLE_LIMIT);
+
+        for (size_t j = 0; j < out[v].size(); j++) {
+            Arc outArc = out[v][j];
+            int w = outArc.node;
+            double viaV = inArc.weight + outArc.weight;
+            if (contracted[w] || w == u || ws.distance(w) <= viaV) {
+                continue;
+            }
+
+            added++;
+            if (simulate) {
+                continue;
+            }
+
+            // reuse an existing u -> w edge if there is one, the
+            // witness search already showed it is longer
+            bool found = false;
+            for (Arc& a : out[u]) {
+                if (a.node == w) {
+                    a.weight = viaV;
+                    a.middle = v;
+                    found = true;
+                }
+            }
+            for (Arc& a : in[w]) {
+                if (a.node == u) {
+                    a.weight = viaV;
+                    a.middle = v;
+                }
+            }
+            if (!found) {
+                out[u].push_back({w, viaV, v});
+                in[w].push_back({u, viaV, v});
+            }
+        }
+    }
+    return added;
+}
+
+//==============================================================
+// witnessSearch
+// INPUTS: Start node, node to avoid, distance limit, the graph
+//         being contracted, contracted nodes, a workspace and the
+//         most nodes to settle
+// OUTPUTS: NONE (distances are left in the workspace)
+// Dijkstra's over the nodes not yet contracted that stops at the
+// distance limit or once enough nodes are settled
+//==============================================================
+template <class T>
+void ContractionHierarchy<T>::witnessSearch(int source, int skip, double maxDist, const vector<vector<Arc> >& out,
+                                            const vector<bool>& contracted, SearchWorkspace& ws, int limit) const {
+    ws.reset(out.size());
+    ws.update(source, 0, -1);
+    ws.queue.insert(source, 0);
+
+    while (!ws.queue.isEmpty() && ws.settled < limit) {
+        auto [current, currentDist] = ws.queue.extractMin();
+        ws.settled++;
+        if (currentDist > maxDist) {
+            break;
+        }
+
+        for (const Arc& a : out[current]) {
+            if (a.node == skip || contracted[a.node]) {
+                continue;
+            }
+            double newDist = currentDist + a.weight;
+            if (!ws.reached(a.node)) {
+                ws.update(a.node, newDist, current);
+                ws.queue.insert(a.node, newDist);
+            }
+            else if (ws.distance(a.node) > newDist) {
+                ws.update(a.node, newDist, current);
+                ws.queue.decreaseKey(a.node, newDist);
+            }
+        }
+    }
+}
+
+//==============================================================
+// query
+// INPUTS: Dense source and target indices, forward and backward
+//         workspaces, vector to write the path into
+// OUTPUTS: Shortest path distance from source to target, infinity
+//          if the target cannot be reached
+// Runs a forward search over upward edges from the source and a
+// backward search over downward edges from the target. Both only
+// climb the hierarchy, so each settles a small set of nodes; a side
+// stops once its queue minimum reaches the best meeting distance.
+// The path (original nodes, shortcuts unpacked) is written to path.
+//==============================================================
+template <class T>
+double ContractionHierarchy<T>::query(int source, int target, SearchWorkspace& forward,
+                                      SearchWorkspace& backward, vector<int>& path) const {
+    forward.reset(numNodes());
+    backward.reset(numNodes());
+    forward.update(source, 0, -1);
+    forward.queue.insert(source, 0);
+    backward.update(target, 0, -1);
+    backward.queue.insert(target, 0);
+
+    double mu = source == target ? 0 : numeric_limits<double>::infinity();
+    int meet = source == target ? source : -1;
+
+    while (true) {
+        bool forwardDone = forward.queue.isEmpty() || forward.queue.peekMin().second >= mu;
+        bool backwardDone = backward.queue.isEmpty() || backward.queue.peekMin().second >= mu;
+        if (forwardDone && backwardDone) {
+            break;
+        }
+
+        if (!forwardDone && (backwardDone || forward.queue.peekMin().second <= backward.queue.peekMin().second)) {
+            auto [current, currentDist] = forward.queue.extractMin();
+            forward.settled++;
+
+            for (int e = upOffsets[current]; e < upOffsets[current + 1]; e++) {
+                int neighbor = upTargets[e];
+                double newDist = currentDist + upWeights[e];
+
+                if (!forward.reached(neighbor)) {
+                    forward.update(neighbor, newDist, current);
+                    forward.queue.insert(neighbor, newDist);
+                }
+                else if (forward.distance(neighbor) > newDist) {
+                    forward.update(neighbor, newDist, current);
+                    forward.queue.decreaseKey(neighbor, newDist);
+                }
+
+                if (backward.reached(neighbor) && forward.distance(neighbor) + backward.distance(neighbor) < mu) {
+                    mu = forward.distance(neighbor) + backward.distance(neighbor);
+                    meet = neighbor;
+                }
+            }
+        }
+        else {
+            auto [current, currentDist] = backward.queue.extractMin();
+            backward.settled++;
+
+            for (int e = downOffsets[current]; e < downOffsets[current + 1]; e++) {
+                int neighbor = downSources[e];
+                double newDist = currentDist + downWeights[e];
+
+                if (!backward.reached(neighbor)) {
+                    backward.update(neighbor, newDist, current);
+                    backward.queue.insert(neighbor, newDist);
+                }
+                else if (backward.distance(neighbor) > newDist) {
+                    backward.update(neighbor, newDist, current);
+                    backward.queue.decreaseKey(neighbor, newDist);
+                }
+
+                if (forward.reached(neighbor) && forward.distance(neighbor) + backward.distance(neighbor) < mu) {
+                    mu = forward.distance(neighbor) + backward.distance(neighbor);
+                    meet = neighbor;
+                }
+            }
+        }
+    }
+
+    forward.settled += backward.settled;
+    path.clear();
+    if (meet == -1) {
+        return numeric_limits<double>::infinity();
+    }
+
+    // hierarchy path: forward parents down to the source, then
+    // backward parents up to the target
+    vector<int> hops = forward.path(meet);
+    for (int u = backward.parentOf(meet); u != -1; u = backward.parentOf(u)) {
+        hops.push_back(u);
+    }
+
+    path.push_back(source);
+    for (size_t i = 0; i + 1 < hops.size(); i++) {
+        unpackEdge(hops[i], hops[i + 1], path);
+    }
+    return mu;
+}
+
+//==============================================================
+// unpackEdge
+// INPUTS: Ends of a hierarchy edge, path to append to
+// OUTPUTS: NONE
+// Appends the original nodes after u on the edge u -> v. A
+// shortcut over m is replaced by u -> m and m -> v; m was
+// contracted before u and v, so u -> m is a downward edge stored
+// at m and m -> v is an upward edge stored at m.
+//==============================================================
+template <class T>
+void ContractionHierarchy<T>::unpackEdge(int u, int v, vector<int>& path) const {
+    int middle = -1;
+    if (rank[v] > rank[u]) {
+        for (int e = upOffsets[u]; e < upOffsets[u + 1]; e++) {
+            if (upTargets[e] == v) {
+                middle = upMiddles[e];
+            }
+        }
+    }
+    else {
+        for (int e = downOffsets[v]; e < downOffsets[v + 1]; e++) {
+            if (downSources[e] == u) {
+                middle = downMiddles[e];
+            }
+        }
+    }
+
+    if (middle == -1) {
+        path.push_back(v);
+        return;
+    }
+    unpackEdge(u, middle, path);
+    unpackEdge(middle, v, path);
+}
+
+// class instantiations
+template class ContractionHierarchy<long>;
+template class ContractionHierarchy<long long>;
+template class ContractionHierarchy<int>;
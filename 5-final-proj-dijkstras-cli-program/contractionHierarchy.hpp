@@ -0,0 +1,66 @@
+//=========================================================
+// ContractionHierarchy.hpp
+// Andrew McCutchan, Namu Kim
+// Header file containing all function delcarations for
+// ContractionHierarchy class. Preprocesses a CSRGraph by
+// contracting nodes in order of importance and answers
+// point-to-point queries with two upward searches.
+// 12/18/2024
+//=========================================================
+
+#ifndef CONTRACTION_HIERARCHY_HPP
+#define CONTRACTION_HIERARCHY_HPP
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include "csrGraph.hpp"
+#include "searchWorkspace.hpp"
+#include "indexedPriorityQueue.hpp"
+using namespace std;
+
+template <typename T>
+class ContractionHierarchy {
+    private:
+        // edge of the graph while it is being contracted; middle is the
+        // node a shortcut skips over, -1 for an original edge
+        struct Arc {
+            int     node;
+            double  weight;
+            int     middle;
+        };
+
+        vector<int>     rank;           // contraction order of each node
+        int             shortcuts;
+
+        // upward graph: edges u -> v with rank[v] > rank[u], stored at u
+        vector<int>     upOffsets;
+        vector<int>     upTargets;
+        vector<double>  upWeights;
+        vector<int>     upMiddles;
+
+        // downward graph: edges u -> v with rank[u] > rank[v], stored
+        // at v so the backward search can walk them from head to tail
+        vector<int>     downOffsets;
+        vector<int>     downSources;
+        vector<double>  downWeights;
+        vector<int>     downMiddles;
+
+        int     contractNode(int v, vector<vector<Arc> >& out, vector<vector<Arc> >& in,
+                             const vector<bool>& contracted, SearchWorkspace& ws, bool simulate);
+        void    witnessSearch(int source, int skip, double maxDist, const vector<vector<Arc> >& out,
+                              const vector<bool>& contracted, SearchWorkspace& ws, int limit) const;
+        void    unpackEdge(int u, int v, vector<int>& path) const;
+
+    public:
+                ContractionHierarchy();
+                ContractionHierarchy(const CSRGraph<T>& graph);
+        double  query(int source, int target, SearchWorkspace& forward, SearchWorkspace& backward, vector<int>& path) const;
+
+        // getter functions
+        int     numNodes() const { return rank.size(); }
+        int     numShortcuts() const { return shortcuts; }
+        int     getRank(int u) const { return rank[u]; }
+};
+
+#endif
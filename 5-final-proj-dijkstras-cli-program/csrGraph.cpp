@@ -0,0 +1,942 @@
+//=========================================================
+// CSRGraph.cpp
+// Andrew McCutchan, Namu Kim
+// Implementaiton file for CSRGraph class
+// 12/18/2024
+//=========================================================
+
+#include "csrGraph.hpp"
+
+// Binary graph files start with this header, followed by the id,
+// coordinate, forward edge, reverse edge and spatial index arrays,
+// then the sorted ID lookup of a reordered graph, each padded to 8
+// bytes. Everything is in the machine's native byte
+// order. checksum covers every byte after the header.
+struct GraphFileHeader {
+    char        magic[8];
+    uint32_t    version;
+    uint32_t    idSize;         // sizeof(T) of the graph that wrote the file
+    uint64_t    numNodes;
+    uint64_t    numEdges;
+    uint64_t    indexSize;      // nodes in the spatial index
+    uint32_t    geographic;
+    uint32_t    reordered;      // 1 if the ID lookup arrays are present (always 0 in version 1)
+    double      minRatio;
+    uint64_t    checksum;
+};
+
+const char GRAPH_FILE_MAGIC[8] = {'W', 'G', 'R', 'A', 'P', 'H', 'B', '\0'};
+const uint32_t GRAPH_FILE_VERSION = 2;
+
+//==============================================================
+// paddedSize
+// INPUTS: Length of a section in bytes
+// OUTPUTS: Length rounded up to a multiple of 8
+//==============================================================
+static size_t paddedSize(size_t length) {
+    return (length + 7) / 8 * 8;
+}
+
+//==============================================================
+// checksumWords
+// INPUTS: Running checksum, bytes to add and their length
+// OUTPUTS: Updated checksum
+// FNV-1a over 64-bit words instead of single bytes so verifying a
+// large file stays fast. A trailing partial word is padded with
+// zeros, which matches the zero padding written between sections.
+//==============================================================
+static uint64_t checksumWords(uint64_t hash, const char* bytes, size_t length) {
+    const uint64_t prime = 1099511628211ULL;
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        uint64_t word;
+        memcpy(&word, bytes + i, 8);
+        hash = (hash ^ word) * prime;
+    }
+    if (i < length) {
+        uint64_t word = 0;
+        memcpy(&word, bytes + i, length - i);
+        hash = (hash ^ word) * prime;
+    }
+    return hash;
+}
+
+//==============================================================
+// Default Constructor
+// INPUTS: NONE
+// OUTPUTS: NONE
+// Creates an empty CSR graph with no nodes or edges
+//==============================================================
+template <class T>
+CSRGraph<T>::CSRGraph() {
+    offsets.assign(vector<int>(1, 0));
+    rOffsets.assign(vector<int>(1, 0));
+    geographic = false;
+    minRatio = 0;
+}
+
+//==============================================================
+// Constructor
+// INPUTS: Coordinate map and adjacency list of a WeightedGraph
+// OUTPUTS: NONE
+// Freezes the graph into CSR form. Every ID that appears as a
+// vertex, an edge source or an edge target gets a dense index
+// (in ascending ID order), and each node's out-edges are stored
+// sorted by target so the layout does not depend on hash order.
+// Nodes without coordinates get NaN coordinates.
+//==============================================================
+template <class T>
+CSRGraph<T>::CSRGraph(const unordered_map<T, pair<double, double> >& coords,
+                      const unordered_map<T, unordered_map<T, double> >& adjacencyList) {
+    vector<T> idList;
+    idList.reserve(coords.size() + adjacencyList.size());
+    for (const auto& [id, _] : coords) {
+        idList.push_back(id);
+    }
+    for (const auto& [u, neighbors] : adjacencyList) {
+        idList.push_back(u);
+        for (const auto& [v, _] : neighbors) {
+            idList.push_back(v);
+        }
+    }
+    sort(idList.begin(), idList.end());
+    idList.erase(unique(idList.begin(), idList.end()), idList.end());
+    ids.assign(move(idList));
+
+    int n = ids.size();
+    vector<double> coordList(2 * n, numeric_limits<double>::quiet_NaN());
+    for (const auto& [id, coord] : coords) {
+        int u = denseId(id);
+        coordList[2 * u] = coord.first;
+        coordList[2 * u + 1] = coord.second;
+    }
+
+    // count out-degrees, then prefix sum them into offsets
+    vector<int> offsetList(n + 1, 0);
+    for (const auto& [u, neighbors] : adjacencyList) {
+        offsetList[denseId(u) + 1] = neighbors.size();
+    }
+    for (int u = 0; u < n; u++) {
+        offsetList[u + 1] += offsetList[u];
+    }
+
+    vector<int> targetList(offsetList[n]);
+    vector<double> weightList(offsetList[n]);
+    vector<pair<int, double> > edges;
+    for (const auto& [id, neighbors] : adjacencyList) {
+        int u = denseId(id);
+        edges.clear();
+        for (const auto& [v, weight] : neighbors) {
+            edges.push_back(make_pair(denseId(v), weight));
+        }
+        sort(edges.begin(), edges.end());
+
+        for (size_t i = 0; i < edges.size(); i++) {
+            targetList[offsetList[u] + i] = edges[i].first;
+            weightList[offsetList[u] + i] = edges[i].second;
+        }
+    }
+
+    assemble(move(coordList), move(offsetList), move(targetList), move(weightList));
+}
+
+//==============================================================
+// Constructor
+// INPUTS: Sorted node IDs, interleaved coordinates and forward CSR
+//         arrays over their dense indices (targets sorted within
+//         each node)
+// OUTPUTS: NONE
+// Takes ownership of arrays a loader already built, skipping the
+// hash maps entirely
+//==============================================================
+template <class T>
+CSRGraph<T>::CSRGraph(vector<T>&& idList, vector<double>&& coordList, vector<int>&& offsetList,
+                      vector<int>&& targetList, vector<double>&& weightList) {
+    ids.assign(move(idList));
+    assemble(move(coordList), move(offsetList), move(targetList), move(weightList));
+}
+
+//==============================================================
+// assemble
+// INPUTS: Interleaved coordinates and forward CSR arrays over the
+//         dense indices in ids
+// OUTPUTS: NONE
+// Takes ownership of the forward arrays and derives everything
+// else from them: the reverse (in-edge) arrays, so backward
+// searches can walk edges against their direction, the spatial
+// index (nodes with NaN coordinates are left out of it) and the
+// A* bound.
+//==============================================================
+template <class T>
+void CSRGraph<T>::assemble(vector<double>&& coordList, vector<int>&& offsetList,
+                           vector<int>&& targetList, vector<double>&& weightList) {
+    int n = ids.size();
+    vector<pair<double, double> > points(n);
+    for (int u = 0; u < n; u++) {
+        points[u] = make_pair(coordList[2 * u], coordList[2 * u + 1]);
+    }
+    index = KDTree(points);
+
+    // transpose with a counting sort on the edge heads
+    vector<int> rOffsetList(n + 1, 0);
+    for (int target : targetList) {
+        rOffsetList[target + 1]++;
+    }
+    for (int v = 0; v < n; v++) {
+        rOffsetList[v + 1] += rOffsetList[v];
+    }
+
+    vector<int> rSourceList(targetList.size());
+    vector<double> rWeightList(targetList.size());
+    vector<int> next(rOffsetList.begin(), rOffsetList.end() - 1);
+    for (int u = 0; u < n; u++) {
+        for (int e = offsetList[u]; e < offsetList[u + 1]; e++) {
+            int slot = next[targetList[e]]++;
+            rSourceList[slot] = u;
+            rWeightList[slot] = weightList[e];
+        }
+    }
+
+    coordData.assign(move(coordList));
+    offsets.assign(move(offsetList));
+    targets.assign(move(targetList));
+    weights.assign(move(weightList));
+    rOffsets.assign(move(rOffsetList));
+    rSources.assign(move(rSourceList));
+    rWeights.assign(move(rWeightList));
+
+    computeMinRatio();
+}
+
+//==============================================================
+// save
+// INPUTS: File name
+// OUTPUTS: NONE
+// Writes the graph in the binary format read by mapFile: a header
+// with counts and a checksum, then every array exactly as it sits
+// in memory so loading needs no parsing
+//==============================================================
+template <class T>
+void CSRGraph<T>::save(const string& filename) const {
+    ofstream file(filename, ios::binary);
+    if (!file) {
+        throw runtime_error("could not open file for writing");
+    }
+
+    GraphFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, GRAPH_FILE_MAGIC, 8);
+    header.version = GRAPH_FILE_VERSION;
+    header.idSize = sizeof(T);
+    header.numNodes = numNodes();
+    header.numEdges = numEdges();
+    header.indexSize = index.size();
+    header.geographic = geographic;
+    header.reordered = sortedIds.size() > 0;
+    header.minRatio = minRatio;
+    header.checksum = 14695981039346656037ULL;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    vector<pair<const void*, size_t> > sections = {
+        {ids.data(), ids.size() * sizeof(T)},
+        {coordData.data(), coordData.size() * sizeof(double)},
+        {offsets.data(), offsets.size() * sizeof(int)},
+        {targets.data(), targets.size() * sizeof(int)},
+        {weights.data(), weights.size() * sizeof(double)},
+        {rOffsets.data(), rOffsets.size() * sizeof(int)},
+        {rSources.data(), rSources.size() * sizeof(int)},
+        {rWeights.data(), rWeights.size() * sizeof(double)},
+        {index.nodeData(), index.size() * sizeof(int)},
+        {index.xData(), index.size() * sizeof(double)},
+        {index.yData(), index.size() * sizeof(double)},
+        {sortedIds.data(), sortedIds.size() * sizeof(T)},
+        {idIndex.data(), idIndex.size() * sizeof(int)}
+    };
+
+    const char zeros[8] = {0};
+    for (const auto& [bytes, length] : sections) {
+        file.write(static_cast<const char*>(bytes), length);
+        file.write(zeros, paddedSize(length) - length);
+        header.checksum = checksumWords(header.checksum, static_cast<const char*>(bytes), length);
+    }
+
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (!file) {
+        throw runtime_error("could not write graph file");
+    }
+}
+
+//==============================================================
+// mapFile
+// INPUTS: File written by save, whether to verify its checksum
+// OUTPUTS: CSR graph served straight from the mapped file
+// Memory-maps the file and points every array at its section, so
+// opening a graph costs no parsing and no per-node or per-edge
+// allocation. Verifying the checksum reads the whole file once;
+// skip it for trusted files to only touch pages queries need.
+//==============================================================
+template <class T>
+CSRGraph<T> CSRGraph<T>::mapFile(const string& filename, bool verify) {
+    CSRGraph<T> g;
+    g.mapping = make_shared<MappedFile>(filename);
+    const char* bytes = g.mapping->data();
+    size_t length = g.mapping->size();
+
+    GraphFileHeader header;
+    if (length < sizeof(header)) {
+        throw runtime_error("not a binary graph file");
+    }
+    memcpy(&header, bytes, sizeof(header));
+    if (memcmp(header.magic, GRAPH_FILE_MAGIC, 8) != 0) {
+        throw runtime_error("not a binary graph file");
+    }
+    if (header.version != GRAPH_FILE_VERSION && header.version != 1) {
+        throw runtime_error("unsupported binary graph version");
+    }
+    if (header.idSize != sizeof(T)) {
+        throw runtime_error("binary graph was written with a different node ID type");
+    }
+
+    size_t n = header.numNodes, m = header.numEdges, k = header.indexSize;
+    size_t lookup = header.reordered ? n : 0;
+    size_t sizes[] = {
+        n * sizeof(T), 2 * n * sizeof(double),
+        (n + 1) * sizeof(int), m * sizeof(int), m * sizeof(double),
+        (n + 1) * sizeof(int), m * sizeof(int), m * sizeof(double),
+        k * sizeof(int), k * sizeof(double), k * sizeof(double),
+        lookup * sizeof(T), lookup * sizeof(int)
+    };
+    size_t starts[13];
+    size_t position = sizeof(header);
+    for (int i = 0; i < 13; i++) {
+        starts[i] = position;
+        position += paddedSize(sizes[i]);
+    }
+    if (position != length) {
+        throw runtime_error("binary graph file is truncated or corrupt");
+    }
+    if (verify && checksumWords(14695981039346656037ULL, bytes + sizeof(header), length - sizeof(header)) != header.checksum) {
+        throw runtime_error("binary graph checksum mismatch");
+    }
+
+    g.ids.view(reinterpret_cast<const T*>(bytes + starts[0]), n);
+    g.coordData.view(reinterpret_cast<const double*>(bytes + starts[1]), 2 * n);
+    g.offsets.view(reinterpret_cast<const int*>(bytes + starts[2]), n + 1);
+    g.targets.view(reinterpret_cast<const int*>(bytes + starts[3]), m);
+    g.weights.view(reinterpret_cast<const double*>(bytes + starts[4]), m);
+    g.rOffsets.view(reinterpret_cast<const int*>(bytes + starts[5]), n + 1);
+    g.rSources.view(reinterpret_cast<const int*>(bytes + starts[6]), m);
+    g.rWeights.view(reinterpret_cast<const double*>(bytes + starts[7]), m);
+    g.index = KDTree(reinterpret_cast<const int*>(bytes + starts[8]),
+                     reinterpret_cast<const double*>(bytes + starts[9]),
+                     reinterpret_cast<const double*>(bytes + starts[10]), k);
+    if (lookup > 0) {
+        g.sortedIds.view(reinterpret_cast<const T*>(bytes + starts[11]), lookup);
+        g.idIndex.view(reinterpret_cast<const int*>(bytes + starts[12]), lookup);
+    }
+    g.geographic = header.geographic;
+    g.minRatio = header.minRatio;
+    return g;
+}
+
+//==============================================================
+// isBinaryFile
+// INPUTS: File name
+// OUTPUTS: True if the file starts with the binary graph magic
+//==============================================================
+template <class T>
+bool CSRGraph<T>::isBinaryFile(const string& filename) {
+    ifstream file(filename, ios::binary);
+    char magic[8];
+    return file.read(magic, 8) && memcmp(magic, GRAPH_FILE_MAGIC, 8) == 0;
+}
+
+//==============================================================
+// denseId
+// INPUTS: Node ID
+// OUTPUTS: Dense index of the node, -1 if it is not in the graph
+// A binary search over ids, or over the separate sorted copy once
+// the nodes have been reordered
+//==============================================================
+template <class T>
+int CSRGraph<T>::denseId(const T& id) const {
+    if (sortedIds.size() > 0) {
+        auto it = lower_bound(sortedIds.begin(), sortedIds.end(), id);
+        if (it == sortedIds.end() || *it != id) {
+            return -1;
+        }
+        return idIndex[it - sortedIds.begin()];
+    }
+    auto it = lower_bound(ids.begin(), ids.end(), id);
+    if (it == ids.end() || *it != id) {
+        return -1;
+    }
+    return it - ids.begin();
+}
+
+//==============================================================
+// hilbertKey
+// INPUTS: Cell column and row on a 2^16 by 2^16 grid
+// OUTPUTS: Position of the cell along the Hilbert curve
+// Cells next to each other on the curve are next to each other
+// in space, and the curve leaves each square block only after
+// filling it.
+//==============================================================
+static uint64_t hilbertKey(uint32_t x, uint32_t y) {
+    const uint32_t side = 1u << 16;
+    uint64_t key = 0;
+    for (uint32_t s = side / 2; s > 0; s /= 2) {
+        uint32_t rx = (x & s) > 0;
+        uint32_t ry = (y & s) > 0;
+        key += static_cast<uint64_t>(s) * s * ((3 * rx) ^ ry);
+        if (ry == 0) {
+            if (rx == 1) {
+                x = side - 1 - x;
+                y = side - 1 - y;
+            }
+            swap(x, y);
+        }
+    }
+    return key;
+}
+
+//==============================================================
+// hilbertOrder
+// INPUTS: NONE
+// OUTPUTS: Dense indices in Hilbert curve order
+// Scales the bounding box of the coordinates onto the curve's
+// grid. Nodes without coordinates go last, and ties keep ID order.
+//==============================================================
+template <class T>
+vector<int> CSRGraph<T>::hilbertOrder() const {
+    int n = numNodes();
+    double minX = numeric_limits<double>::infinity(), minY = minX;
+    double maxX = -minX, maxY = -minX;
+    for (int u = 0; u < n; u++) {
+        double x = coordData[2 * u], y = coordData[2 * u + 1];
+        if (!isnan(x) && !isnan(y)) {
+            minX = min(minX, x);
+            maxX = max(maxX, x);
+            minY = min(minY, y);
+            maxY = max(maxY, y);
+        }
+    }
+
+    const double cells = (1 << 16) - 1;
+    double scaleX = maxX > minX ? cells / (maxX - minX) : 0;
+    double scaleY = maxY > minY ? cells / (maxY - minY) : 0;
+    vector<pair<pair<uint64_t, T>, int> > keyed(n);
+    for (int u = 0; u < n; u++) {
+        double x = coordData[2 * u], y = coordData[2 * u + 1];
+        uint64_t key = numeric_limits<uint64_t>::max();
+        if (!isnan(x) && !isnan(y)) {
+            key = hilbertKey(static_cast<uint32_t>((x - minX) * scaleX), static_cast<uint32_t>((y - minY) * scaleY));
+        }
+        keyed[u] = make_pair(make_pair(key, ids[u]), u);
+    }
+    sort(keyed.begin(), keyed.end());
+
+    vector<int> order(n);
+    for (int i = 0; i < n; i++) {
+        order[i] = keyed[i].second;
+    }
+    return order;
+}
+
+//==============================================================
+// rcmOrder
+// INPUTS: NONE
+// OUTPUTS: Dense indices in reverse Cuthill-McKee order
+// Breadth-first search over edges in both directions, starting
+// each component from its lowest-degree node and visiting the
+// neighbors of a node from lowest to highest degree, then
+// reversed. Edges end up joining nodes with close indices, which
+// keeps the band of the adjacency matrix narrow.
+//==============================================================
+template <class T>
+vector<int> CSRGraph<T>::rcmOrder() const {
+    int n = numNodes();
+    vector<int> degree(n);
+    vector<int> byDegree(n);
+    for (int u = 0; u < n; u++) {
+        degree[u] = (edgeEnd(u) - edgeBegin(u)) + (reverseEdgeEnd(u) - reverseEdgeBegin(u));
+        byDegree[u] = u;
+    }
+    auto lighter = [&](int a, int b) {
+        return degree[a] != degree[b] ? degree[a] < degree[b] : ids[a] < ids[b];
+    };
+    sort(byDegree.begin(), byDegree.end(), lighter);
+
+    vector<int> order;
+    order.reserve(n);
+    vector<char> visited(n, 0);
+    vector<int> neighbors;
+    for (int start : byDegree) {
+        if (visited[start]) {
+            continue;
+        }
+        visited[start] = 1;
+        order.push_back(start);
+        for (size_t head = order.size() - 1; head < order.size(); head++) {
+            int u = order[head];
+            neighbors.clear();
+            for (int e = edgeBegin(u); e < edgeEnd(u); e++) {
+                if (!visited[targets[e]]) {
+                    visited[targets[e]] = 1;
+                    neighbors.push_back(targets[e]);
+                }
+            }
+            for (int e = reverseEdgeBegin(u); e < reverseEdgeEnd(u); e++) {
+                if (!visited[rSources[e]]) {
+                    visited[rSources[e]] = 1;
+                    neighbors.push_back(rSources[e]);
+                }
+            }
+            sort(neighbors.begin(), neighbors.end(), lighter);
+            order.insert(order.end(), neighbors.begin(), neighbors.end());
+        }
+    }
+    reverse(order.begin(), order.end());
+    return order;
+}
+
+//==============================================================
+// permuted
+// INPUTS: Old dense index of each new dense index
+// OUTPUTS: Copy of the graph with its nodes renumbered
+// Lays the ids, coordinates and out-edges of the copy out in the
+// new order (targets still sorted within each node) and rebuilds
+// everything derived from them. The sorted ID lookup is only kept
+// when the new ids are out of order.
+//==============================================================
+template <class T>
+CSRGraph<T> CSRGraph<T>::permuted(const vector<int>& order) const {
+    int n = numNodes();
+    vector<int> newIndex(n);
+    for (int u = 0; u < n; u++) {
+        newIndex[order[u]] = u;
+    }
+
+    vector<T> idList(n);
+    vector<double> coordList(2 * n);
+    vector<int> offsetList(n + 1, 0);
+    vector<int> targetList(numEdges());
+    vector<double> weightList(numEdges());
+    vector<pair<int, double> > edges;
+    for (int u = 0; u < n; u++) {
+        int old = order[u];
+        idList[u] = ids[old];
+        coordList[2 * u] = coordData[2 * old];
+        coordList[2 * u + 1] = coordData[2 * old + 1];
+
+        edges.clear();
+        for (int e = edgeBegin(old); e < edgeEnd(old); e++) {
+            edges.push_back(make_pair(newIndex[targets[e]], weights[e]));
+        }
+        sort(edges.begin(), edges.end());
+        offsetList[u + 1] = offsetList[u] + edges.size();
+        for (size_t i = 0; i < edges.size(); i++) {
+            targetList[offsetList[u] + i] = edges[i].first;
+            weightList[offsetList[u] + i] = edges[i].second;
+        }
+    }
+
+    CSRGraph<T> g;
+    if (!is_sorted(idList.begin(), idList.end())) {
+        vector<pair<T, int> > lookup(n);
+        for (int u = 0; u < n; u++) {
+            lookup[u] = make_pair(idList[u], u);
+        }
+        sort(lookup.begin(), lookup.end());
+        vector<T> sortedList(n);
+        vector<int> indexList(n);
+        for (int i = 0; i < n; i++) {
+            sortedList[i] = lookup[i].first;
+            indexList[i] = lookup[i].second;
+        }
+        g.sortedIds.assign(move(sortedList));
+        g.idIndex.assign(move(indexList));
+    }
+    g.ids.assign(move(idList));
+    g.assemble(move(coordList), move(offsetList), move(targetList), move(weightList));
+    return g;
+}
+
+//==============================================================
+// reordered
+// INPUTS: Node order
+// OUTPUTS: Copy of the graph with its nodes renumbered in that
+//          order
+// Node IDs, coordinates, edges and weights are unchanged, only the
+// dense indices move. ID_ORDER undoes an earlier reordering.
+//==============================================================
+template <class T>
+CSRGraph<T> CSRGraph<T>::reordered(NodeOrder order) const {
+    switch (order) {
+        case HILBERT_ORDER: return permuted(hilbertOrder());
+        case RCM_ORDER:     return permuted(rcmOrder());
+        default: {
+            vector<int> byId(numNodes());
+            for (int u = 0; u < numNodes(); u++) {
+                byId[u] = u;
+            }
+            sort(byId.begin(), byId.end(), [&](int a, int b) { return ids[a] < ids[b]; });
+            return permuted(byId);
+        }
+    }
+}
+
+//==============================================================
+// geoDistance
+// INPUTS: Two dense node indices
+// OUTPUTS: Straight-line distance between their coordinates:
+//          great-circle meters (haversine) for longitude/latitude
+//          data, plain Euclidean distance otherwise
+//==============================================================
+template <class T>
+double CSRGraph<T>::geoDistance(int u, int v) const {
+    double x1 = coordData[2 * u], y1 = coordData[2 * u + 1];
+    double x2 = coordData[2 * v], y2 = coordData[2 * v + 1];
+
+    if (!geographic) {
+        return hypot(x2 - x1, y2 - y1);
+    }
+
+    const double radians = M_PI / 180.0;
+    const double earthRadius = 6371008.8;
+    double dLat = (y2 - y1) * radians;
+    double dLon = (x2 - x1) * radians;
+    double a = sin(dLat / 2) * sin(dLat / 2) +
+               cos(y1 * radians) * cos(y2 * radians) * sin(dLon / 2) * sin(dLon / 2);
+    return 2 * earthRadius * asin(min(1.0, sqrt(a)));
+}
+
+//==============================================================
+// computeMinRatio
+// INPUTS: NONE
+// OUTPUTS: NONE
+// Finds the smallest weight / geoDistance ratio over all edges.
+// Since geoDistance obeys the triangle inequality, minRatio times
+// the distance to the target never overestimates the remaining
+// path weight, which makes it a consistent A* heuristic. If any
+// node lacks coordinates or an edge has a negative weight the
+// bound can't be proven and minRatio is left at 0.
+//==============================================================
+template <class T>
+void CSRGraph<T>::computeMinRatio() {
+    geographic = true;
+    minRatio = 0;
+    for (int u = 0; u < numNodes(); u++) {
+        double x = coordData[2 * u], y = coordData[2 * u + 1];
+        if (isnan(x) || isnan(y)) {
+            return;
+        }
+        if (fabs(x) > 180 || fabs(y) > 90) {
+            geographic = false;
+        }
+    }
+
+    double ratio = numeric_limits<double>::infinity();
+    for (int u = 0; u < numNodes(); u++) {
+        for (int e = edgeBegin(u); e < edgeEnd(u); e++) {
+            if (weights[e] < 0) {
+                return;
+            }
+            double dist = geoDistance(u, targets[e]);
+            if (dist > 0) {
+                ratio = min(ratio, weights[e] / dist);
+            }
+        }
+    }
+
+    // shave off a little so rounding in geoDistance can't make the
+    // heuristic overestimate
+    if (ratio != numeric_limits<double>::infinity()) {
+        minRatio = ratio * (1 - 1e-9);
+    }
+}
+
+//==============================================================
+// runDijkstras
+// INPUTS: Dense source index, target index or a sorted list of
+//         targets (at most one is used, the other is -1/nullptr),
+//         distance cutoff, workspace and the queue to search with
+// OUTPUTS: Distance to target, or 0 when searching for a list
+// Lazy Dijkstra shared by dijkstras(), oneToMany() and oneToAll(),
+// written once for every queue type: nodes only enter the queue
+// once they are discovered, and the search stops as soon as the
+// target (or every target in the list) is settled, or the next
+// node is further away than the cutoff.
+//==============================================================
+template <class T>
+template <typename Q>
+double CSRGraph<T>::runDijkstras(int source, int target, const vector<int>* targetList, double cutoff,
+                                 SearchWorkspace& ws, Q& queue) const {
+    ws.reset(numNodes());
+    ws.update(source, 0, -1);
+    queue.insert(source, 0);
+    int remaining = targetList ? targetList->size() : 1;
+
+    while (!queue.isEmpty() && remaining > 0) {
+        auto [current, currentDist] = queue.extractMin();
+        if (currentDist > cutoff) {
+            break;
+        }
+        ws.settled++;
+
+        if (targetList == nullptr && current == target) {
+            return currentDist;
+        }
+        if (targetList != nullptr && binary_search(targetList->begin(), targetList->end(), current)) {
+            remaining--;
+        }
+
+        for (int e = edgeBegin(current); e < edgeEnd(current); e++) {
+            int neighbor = targets[e];
+            double newDist = currentDist + weights[e];
+
+            // a reached node that can still improve is still queued,
+            // settled nodes never improve with non-negative weights
+            if (!ws.reached(neighbor)) {
+                ws.update(neighbor, newDist, current);
+                queue.insert(neighbor, newDist);
+            }
+            else if (ws.distance(neighbor) > newDist) {
+                ws.update(neighbor, newDist, current);
+                queue.decreaseKey(neighbor, newDist);
+            }
+        }
+    }
+
+    return targetList ? 0 : numeric_limits<double>::infinity();
+}
+
+//==============================================================
+// Dijkstra's
+// INPUTS: Dense source and target indices, workspace to search in
+// OUTPUTS: Shortest path distance from source to target, infinity
+//          if the target cannot be reached
+// Nodes only enter the queue once they are discovered and the
+// search stops as soon as the target is settled, so the cost
+// depends on the explored region rather than the whole graph.
+// ws.queueType picks the priority queue. The path can be read
+// back with ws.path(target).
+//==============================================================
+template <class T>
+double CSRGraph<T>::dijkstras(int source, int target, SearchWorkspace& ws) const {
+    switch (ws.queueType) {
+        case RADIX_HEAP:    return runDijkstras(source, target, nullptr, numeric_limits<double>::infinity(), ws, ws.radixQueue);
+        case DIAL_BUCKETS:  return runDijkstras(source, target, nullptr, numeric_limits<double>::infinity(), ws, ws.dialQueue);
+        default:            return runDijkstras(source, target, nullptr, numeric_limits<double>::infinity(), ws, ws.queue);
+    }
+}
+
+//==============================================================
+// oneToMany
+// INPUTS: Dense source index, dense target indices sorted ascending
+//         without repeats, workspace to search in
+// OUTPUTS: NONE
+// One Dijkstra search from the source that stops as soon as every
+// target is settled, instead of one search per target. Distances
+// are read back with ws.distance(t), infinity for targets that
+// cannot be reached.
+//==============================================================
+template <class T>
+void CSRGraph<T>::oneToMany(int source, const vector<int>& targetList, SearchWorkspace& ws) const {
+    switch (ws.queueType) {
+        case RADIX_HEAP:    runDijkstras(source, -1, &targetList, numeric_limits<double>::infinity(), ws, ws.radixQueue); break;
+        case DIAL_BUCKETS:  runDijkstras(source, -1, &targetList, numeric_limits<double>::infinity(), ws, ws.dialQueue); break;
+        default:            runDijkstras(source, -1, &targetList, numeric_limits<double>::infinity(), ws, ws.queue); break;
+    }
+}
+
+//==============================================================
+// oneToAll
+// INPUTS: Dense source index, distance cutoff (infinity for none),
+//         workspace to search in, arrays to write into
+// OUTPUTS: Number of nodes within the cutoff, source included
+// One Dijkstra search that settles every node no further than the
+// cutoff. distances[u] and parents[u] are filled for each of them
+// (parents[source] is -1), and every other node gets infinity and
+// -1. The arrays are resized to numNodes() and keep their memory
+// from one call to the next.
+//==============================================================
+template <class T>
+int CSRGraph<T>::oneToAll(int source, double cutoff, SearchWorkspace& ws,
+                          vector<double>& distances, vector<int>& parents) const {
+    switch (ws.queueType) {
+        case RADIX_HEAP:    runDijkstras(source, -1, nullptr, cutoff, ws, ws.radixQueue); break;
+        case DIAL_BUCKETS:  runDijkstras(source, -1, nullptr, cutoff, ws, ws.dialQueue); break;
+        default:            runDijkstras(source, -1, nullptr, cutoff, ws, ws.queue); break;
+    }
+
+    // the search only stops early at a node past the cutoff, so
+    // every reached node within it has been settled
+    distances.assign(numNodes(), numeric_limits<double>::infinity());
+    parents.assign(numNodes(), -1);
+    int count = 0;
+    for (int u = 0; u < numNodes(); u++) {
+        if (ws.reached(u) && ws.distance(u) <= cutoff) {
+            distances[u] = ws.distance(u);
+            parents[u] = ws.parentOf(u);
+            count++;
+        }
+    }
+    return count;
+}
+
+//==============================================================
+// Bidirectional Dijkstra's
+// INPUTS: Dense source and target indices, one workspace for the
+//         forward search and one for the backward search
+// OUTPUTS: Shortest path distance from source to target, infinity
+//          if the target cannot be reached
+// Grows a forward search from the source over out-edges and a
+// backward search from the target over in-edges, always advancing
+// the side whose queue has the smaller key. mu is the best path
+// seen where the two searches touch; once the two queue minimums
+// add up to at least mu no better path can exist. The full path
+// is stitched into the forward workspace, so forward.path(target)
+// reads it back, and settled counts are added into forward.settled.
+//==============================================================
+template <class T>
+double CSRGraph<T>::bidirectionalDijkstras(int source, int target, SearchWorkspace& forward, SearchWorkspace& backward) const {
+    forward.reset(numNodes());
+    backward.reset(numNodes());
+    forward.update(source, 0, -1);
+    forward.queue.insert(source, 0);
+    backward.update(target, 0, -1);
+    backward.queue.insert(target, 0);
+
+    double mu = source == target ? 0 : numeric_limits<double>::infinity();
+    int meet = source == target ? source : -1;
+
+    while (!forward.queue.isEmpty() && !backward.queue.isEmpty()) {
+        double forwardMin = forward.queue.peekMin().second;
+        double backwardMin = backward.queue.peekMin().second;
+        if (forwardMin + backwardMin >= mu) {
+            break;
+        }
+
+        if (forwardMin <= backwardMin) {
+            auto [current, currentDist] = forward.queue.extractMin();
+            forward.settled++;
+
+            for (int e = edgeBegin(current); e < edgeEnd(current); e++) {
+                int neighbor = targets[e];
+                double newDist = currentDist + weights[e];
+
+                if (!forward.reached(neighbor)) {
+                    forward.update(neighbor, newDist, current);
+                    forward.queue.insert(neighbor, newDist);
+                }
+                else if (forward.distance(neighbor) > newDist) {
+                    forward.update(neighbor, newDist, current);
+                    forward.queue.decreaseKey(neighbor, newDist);
+                }
+
+                if (backward.reached(neighbor) && newDist + backward.distance(neighbor) < mu) {
+                    mu = newDist + backward.distance(neighbor);
+                    meet = neighbor;
+                }
+            }
+        }
+        else {
+            auto [current, currentDist] = backward.queue.extractMin();
+            backward.settled++;
+
+            for (int e = reverseEdgeBegin(current); e < reverseEdgeEnd(current); e++) {
+                int neighbor = rSources[e];
+                double newDist = currentDist + rWeights[e];
+
+                if (!backward.reached(neighbor)) {
+                    backward.update(neighbor, newDist, current);
+                    backward.queue.insert(neighbor, newDist);
+                }
+                else if (backward.distance(neighbor) > newDist) {
+                    backward.update(neighbor, newDist, current);
+                    backward.queue.decreaseKey(neighbor, newDist);
+                }
+
+                if (forward.reached(neighbor) && newDist + forward.distance(neighbor) < mu) {
+                    mu = newDist + forward.distance(neighbor);
+                    meet = neighbor;
+                }
+            }
+        }
+    }
+
+    forward.settled += backward.settled;
+    if (meet == -1) {
+        return numeric_limits<double>::infinity();
+    }
+
+    // backward parents point towards the target, so walking them from
+    // the meeting node continues the forward path up to the target
+    for (int u = meet; u != target; u = backward.parentOf(u)) {
+        int next = backward.parentOf(u);
+        forward.update(next, mu - backward.distance(next), u);
+    }
+    return mu;
+}
+
+//==============================================================
+// A*
+// INPUTS: Dense source and target indices, workspace to search in
+// OUTPUTS: Shortest path distance from source to target, infinity
+//          if the target cannot be reached
+// Dijkstra's ordered by distance plus minRatio * geoDistance to
+// the target, so the search is pulled towards the target instead
+// of growing evenly in every direction. The heuristic is consistent,
+// so settled nodes are final just like in Dijkstra's. Falls back
+// to plain Dijkstra's when the bound can't be used.
+//==============================================================
+template <class T>
+double CSRGraph<T>::aStar(int source, int target, SearchWorkspace& ws) const {
+    if (minRatio <= 0) {
+        return dijkstras(source, target, ws);
+    }
+
+    ws.reset(numNodes());
+    ws.update(source, 0, -1);
+    ws.queue.insert(source, minRatio * geoDistance(source, target));
+
+    while (!ws.queue.isEmpty()) {
+        int current = ws.queue.extractMin().first;
+        double currentDist = ws.distance(current);
+        ws.settled++;
+
+        if (current == target) {
+            return currentDist;
+        }
+
+        for (int e = edgeBegin(current); e < edgeEnd(current); e++) {
+            int neighbor = targets[e];
+            double newDist = currentDist + weights[e];
+
+            if (!ws.reached(neighbor)) {
+                ws.update(neighbor, newDist, current);
+                ws.queue.insert(neighbor, newDist + minRatio * geoDistance(neighbor, target));
+            }
+            else if (ws.distance(neighbor) > newDist) {
+                // a settled node can only improve through rounding in
+                // the heuristic, in which case it is reopened
+                ws.update(neighbor, newDist, current);
+                if (ws.queue.contains(neighbor)) {
+                    ws.queue.decreaseKey(neighbor, newDist + minRatio * geoDistance(neighbor, target));
+                }
+                else {
+                    ws.queue.insert(neighbor, newDist + minRatio * geoDistance(neighbor, target));
+                }
+            }
+        }
+    }
+
+    return numeric_limits<double>::infinity();
+}
+
+// class instantiations
+template class CSRGraph<long>;
+template class CSRGraph<long long>;
+template class CSRGraph<int>;
@@ -0,0 +1,107 @@
+//=========================================================
+// CSRGraph.hpp
+// Andrew McCutchan, Namu Kim
+// Header file containing all function delcarations for
+// CSRGraph class. A CSRGraph is a frozen, compressed sparse
+// row copy of a WeightedGraph: node IDs are mapped to dense
+// indices 0..n-1 and every out-edge lives in contiguous arrays.
+// 12/18/2024
+//=========================================================
+
+#ifndef CSR_GRAPH_HPP
+#define CSR_GRAPH_HPP
+
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+#include <utility>
+#include <limits>
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <memory>
+#include <fstream>
+#include <cstdint>
+#include <cstring>
+#include "indexedPriorityQueue.hpp"
+#include "kdTree.hpp"
+#include "searchWorkspace.hpp"
+#include "flatArray.hpp"
+#include "mappedFile.hpp"
+using namespace std;
+
+// how freeze() numbers the nodes of a graph. Nodes close in space
+// (Hilbert curve) or in the graph (reverse Cuthill-McKee) get close
+// indices, so a search touches fewer cache lines.
+enum NodeOrder {
+    ID_ORDER,
+    HILBERT_ORDER,
+    RCM_ORDER
+};
+
+template <typename T>
+class CSRGraph {
+    private:
+        FlatArray<T>        ids;        // dense index -> node ID, sorted ascending unless reordered
+        FlatArray<T>        sortedIds;  // node IDs sorted ascending, empty while ids is sorted
+        FlatArray<int>      idIndex;    // dense index of each entry of sortedIds
+        FlatArray<double>   coordData;  // x and y of each dense index, interleaved
+        FlatArray<int>      offsets;    // out-edges of u are [offsets[u], offsets[u + 1])
+        FlatArray<int>      targets;    // dense index of each edge's head
+        FlatArray<double>   weights;    // weight of each edge
+        FlatArray<int>      rOffsets;   // in-edges of v are [rOffsets[v], rOffsets[v + 1])
+        FlatArray<int>      rSources;   // dense index of each in-edge's tail
+        FlatArray<double>   rWeights;   // weight of each in-edge
+        KDTree              index;      // spatial index over coordData
+        bool                geographic; // coordinates are longitude/latitude degrees
+        double              minRatio;   // smallest weight / distance over all edges, 0 if A* can't use coords
+        shared_ptr<MappedFile> mapping; // file the arrays point into, if loaded by mapFile
+
+        void            assemble(vector<double>&& coordList, vector<int>&& offsetList,
+                                 vector<int>&& targetList, vector<double>&& weightList);
+        double          geoDistance(int u, int v) const;
+        void            computeMinRatio();
+        vector<int>     hilbertOrder() const;
+        vector<int>     rcmOrder() const;
+        CSRGraph<T>     permuted(const vector<int>& order) const;
+        template <typename Q>
+        double          runDijkstras(int source, int target, const vector<int>* targetList, double cutoff,
+                                     SearchWorkspace& ws, Q& queue) const;
+
+    public:
+                                CSRGraph();
+                                CSRGraph(const unordered_map<T, pair<double, double> >& coords,
+                                         const unordered_map<T, unordered_map<T, double> >& adjacencyList);
+                                CSRGraph(vector<T>&& idList, vector<double>&& coordList, vector<int>&& offsetList,
+                                         vector<int>&& targetList, vector<double>&& weightList);
+                void            save(const string& filename) const;
+        static  CSRGraph<T>     mapFile(const string& filename, bool verify = true);
+        static  bool            isBinaryFile(const string& filename);
+                int             denseId(const T& id) const;
+                CSRGraph<T>     reordered(NodeOrder order) const;
+                int             locate(pair<double, double> coord) const { return index.exact(coord); }
+                int             nearest(pair<double, double> coord) const { return index.nearest(coord); }
+                double          dijkstras(int source, int target, SearchWorkspace& ws) const;
+                void            oneToMany(int source, const vector<int>& targetList, SearchWorkspace& ws) const;
+                int             oneToAll(int source, double cutoff, SearchWorkspace& ws,
+                                         vector<double>& distances, vector<int>& parents) const;
+                double          bidirectionalDijkstras(int source, int target, SearchWorkspace& forward, SearchWorkspace& backward) const;
+                double          aStar(int source, int target, SearchWorkspace& ws) const;
+
+        // getter functions
+                int             numNodes() const { return ids.size(); }
+                int             numEdges() const { return targets.size(); }
+                double          heuristicScale() const { return minRatio; }
+                T               nodeId(int u) const { return ids[u]; }
+                pair<double, double> coord(int u) const { return make_pair(coordData[2 * u], coordData[2 * u + 1]); }
+                int             edgeBegin(int u) const { return offsets[u]; }
+                int             edgeEnd(int u) const { return offsets[u + 1]; }
+                int             target(int e) const { return targets[e]; }
+                double          weight(int e) const { return weights[e]; }
+                int             reverseEdgeBegin(int v) const { return rOffsets[v]; }
+                int             reverseEdgeEnd(int v) const { return rOffsets[v + 1]; }
+                int             reverseSource(int e) const { return rSources[e]; }
+                double          reverseWeight(int e) const { return rWeights[e]; }
+};
+
+#endif
@@ -0,0 +1,291 @@
+//=========================================================
+// DeltaStepping.cpp
+// Andrew McCutchan, Namu Kim
+// Implementaiton file for DeltaStepping class
+// 12/18/2024
+//=========================================================
+
+#include "deltaStepping.hpp"
+
+//==============================================================
+// Constructor
+// INPUTS: Frozen graph to search, number of threads (0 for one
+//         per core)
+// OUTPUTS: NONE
+// Starts with delta set to the mean edge weight. The graph must
+// outlive this object and not change while it is in use.
+//==============================================================
+template <class T>
+DeltaStepping<T>::DeltaStepping(const CSRGraph<T>& graph, int threads) : graph(graph) {
+    this->threads = threadCount(threads);
+    maxWeight = 0;
+    double total = 0;
+    for (int e = 0; e < graph.numEdges(); e++) {
+        maxWeight = max(maxWeight, graph.weight(e));
+        total += graph.weight(e);
+    }
+    meanWeight = graph.numEdges() > 0 ? total / graph.numEdges() : 1;
+    pending = 0;
+    current = 0;
+    frontierStamp = 0;
+    settledStamp = 0;
+    heavyPhase = false;
+    phases = 0;
+    setDelta(0);
+}
+
+//==============================================================
+// setDelta
+// INPUTS: Bucket width, 0 for the mean edge weight
+// OUTPUTS: NONE
+// Edges no heavier than delta are light and are relaxed again and
+// again until their bucket stops changing; heavy edges are relaxed
+// once per bucket. A small delta does less repeated work but
+// gives each phase fewer nodes to share out. A delta above every
+// edge weight turns the search into parallel Bellman-Ford.
+//==============================================================
+template <class T>
+void DeltaStepping<T>::setDelta(double delta) {
+    if (!(delta >= 0) || isinf(delta)) {
+        throw invalid_argument("Delta must be finite and non-negative");
+    }
+    this->delta = delta > 0 ? delta : (meanWeight > 0 ? meanWeight : 1);
+}
+
+//==============================================================
+// newStamp
+// INPUTS: Stamp to move on, marks it is compared against
+// OUTPUTS: NONE
+// Unmarks every node in O(1) by moving to a new stamp
+//==============================================================
+template <class T>
+void DeltaStepping<T>::newStamp(unsigned& stamp, vector<unsigned>& marks) {
+    stamp++;
+    if (stamp == 0) {
+        fill(marks.begin(), marks.end(), 0);
+        stamp = 1;
+    }
+}
+
+//==============================================================
+// relaxPhase
+// INPUTS: Thread index
+// OUTPUTS: NONE
+// Claims chunks of the phase's work list until none are left and
+// relaxes their light edges (or heavy ones in a heavy phase).
+// Distances are lowered with compare-and-swap, so when two threads
+// improve the same node the smaller distance wins, and each node
+// this thread lowers is noted for advance().
+//==============================================================
+template <class T>
+void DeltaStepping<T>::relaxPhase(int thread) {
+    const int CHUNK = 64;
+    const vector<int>& work = heavyPhase ? settledHere : frontier;
+    vector<int>& lowered = improved[thread];
+    int size = work.size();
+
+    for (int begin = next.fetch_add(CHUNK); begin < size; begin = next.fetch_add(CHUNK)) {
+        int end = min(begin + CHUNK, size);
+        for (int i = begin; i < end; i++) {
+            int u = work[i];
+            double du = dist[u].load(memory_order_relaxed);
+            for (int e = graph.edgeBegin(u); e < graph.edgeEnd(u); e++) {
+                double w = graph.weight(e);
+                if ((w > delta) != heavyPhase) {
+                    continue;
+                }
+                int v = graph.target(e);
+                double newDist = du + w;
+                double old = dist[v].load(memory_order_relaxed);
+                while (newDist < old) {
+                    if (dist[v].compare_exchange_weak(old, newDist, memory_order_relaxed)) {
+                        lowered.push_back(v);
+                        break;
+                    }
+                }
+            }
+        }
+    }
+}
+
+//==============================================================
+// takeBucket
+// INPUTS: NONE
+// OUTPUTS: Whether the current bucket had any node in it
+// Moves the nodes of the current bucket into the frontier. Entries
+// of later buckets sharing its slot stay, and entries whose node
+// has since moved to another bucket are dropped.
+//==============================================================
+template <class T>
+bool DeltaStepping<T>::takeBucket() {
+    vector<int>& slot = buckets[current % buckets.size()];
+    size_t kept = 0;
+    for (int v : slot) {
+        long long b = bucketFor(dist[v].load(memory_order_relaxed));
+        if (b == current) {
+            if (frontierMark[v] != frontierStamp) {
+                frontierMark[v] = frontierStamp;
+                frontier.push_back(v);
+            }
+        }
+        else if (b > current && b % static_cast<long long>(buckets.size()) == current % static_cast<long long>(buckets.size())) {
+            slot[kept++] = v;
+        }
+    }
+    pending -= slot.size() - kept;
+    slot.resize(kept);
+    return !frontier.empty();
+}
+
+//==============================================================
+// advance
+// INPUTS: NONE
+// OUTPUTS: Whether there is another phase to run
+// Runs on one thread between phases. Nodes lowered into the
+// current bucket form the next light phase, the others go to
+// their own buckets. Once the current bucket stops changing its
+// heavy edges are relaxed, and then the next non-empty bucket is
+// started.
+//==============================================================
+template <class T>
+bool DeltaStepping<T>::advance() {
+    if (heavyPhase) {
+        settledHere.clear();
+        newStamp(settledStamp, settledMark);
+    }
+    else {
+        for (int u : frontier) {
+            if (settledMark[u] != settledStamp) {
+                settledMark[u] = settledStamp;
+                settledHere.push_back(u);
+            }
+        }
+    }
+    frontier.clear();
+    newStamp(frontierStamp, frontierMark);
+
+    // lowered distances are never below the current bucket's start
+    // since weights are non-negative
+    for (vector<int>& lowered : improved) {
+        for (int v : lowered) {
+            long long b = bucketFor(dist[v].load(memory_order_relaxed));
+            if (b <= current) {
+                if (frontierMark[v] != frontierStamp) {
+                    frontierMark[v] = frontierStamp;
+                    frontier.push_back(v);
+                }
+            }
+            else {
+                buckets[b % buckets.size()].push_back(v);
+                pending++;
+            }
+        }
+        lowered.clear();
+    }
+
+    if (!frontier.empty()) {
+        heavyPhase = false;
+        return true;
+    }
+    if (!settledHere.empty()) {
+        heavyPhase = true;
+        return true;
+    }
+    while (pending > 0) {
+        current++;
+        if (takeBucket()) {
+            heavyPhase = false;
+            return true;
+        }
+    }
+    return false;
+}
+
+//==============================================================
+// run
+// INPUTS: Dense source index, array to write into
+// OUTPUTS: Number of nodes reached, source included
+// Fills distances[u] with the distance from the source to every
+// node, infinity if it can't be reached, the same as oneToAll()
+// with no cutoff. Each phase is shared out over the threads, which
+// meet at a barrier after it while one of them picks the next
+// phase. With one thread no threads are started.
+//==============================================================
+template <class T>
+int DeltaStepping<T>::run(int source, vector<double>& distances) {
+    int n = graph.numNodes();
+    if (source < 0 || source >= n) {
+        throw invalid_argument("Source index out of range");
+    }
+
+    if (static_cast<int>(dist.size()) != n) {
+        dist = vector<atomic<double> >(n);
+        frontierMark.assign(n, 0);
+        settledMark.assign(n, 0);
+    }
+    for (atomic<double>& d : dist) {
+        d.store(numeric_limits<double>::infinity(), memory_order_relaxed);
+    }
+    size_t slots = min(static_cast<double>(MAX_SLOTS), floor(maxWeight / delta) + 2);
+    if (buckets.size() != slots) {
+        buckets.assign(slots, vector<int>());
+    }
+    for (vector<int>& slot : buckets) {
+        slot.clear();
+    }
+    improved.resize(threads);
+    for (vector<int>& lowered : improved) {
+        lowered.clear();
+    }
+
+    pending = 0;
+    current = 0;
+    phases = 0;
+    heavyPhase = false;
+    settledHere.clear();
+    newStamp(settledStamp, settledMark);
+    frontier.assign(1, source);
+    newStamp(frontierStamp, frontierMark);
+    frontierMark[source] = frontierStamp;
+    dist[source].store(0, memory_order_relaxed);
+    next.store(0);
+
+    if (threads == 1) {
+        do {
+            relaxPhase(0);
+            phases++;
+            next.store(0);
+        } while (advance());
+    }
+    else {
+        Barrier barrier(threads);
+        bool more = true;
+        runParallel(threads, [&](int t) {
+            while (more) {
+                relaxPhase(t);
+                barrier.wait();
+                if (t == 0) {
+                    phases++;
+                    next.store(0);
+                    more = advance();
+                }
+                barrier.wait();
+            }
+        });
+    }
+
+    distances.resize(n);
+    int reached = 0;
+    for (int u = 0; u < n; u++) {
+        distances[u] = dist[u].load(memory_order_relaxed);
+        if (distances[u] != numeric_limits<double>::infinity()) {
+            reached++;
+        }
+    }
+    return reached;
+}
+
+// class instantiations
+template class DeltaStepping<long>;
+template class DeltaStepping<long long>;
+template class DeltaStepping<int>;
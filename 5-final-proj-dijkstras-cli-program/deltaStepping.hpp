@@ -0,0 +1,72 @@
+//=========================================================
+// DeltaStepping.hpp
+// Andrew McCutchan, Namu Kim
+// Header file containing all function delcarations for
+// DeltaStepping class. Single-source shortest paths over a
+// frozen graph with the delta-stepping algorithm: nodes are
+// grouped into buckets of distance width delta and each
+// bucket is relaxed on several threads at once.
+// 12/18/2024
+//=========================================================
+
+#ifndef DELTA_STEPPING_HPP
+#define DELTA_STEPPING_HPP
+
+#include <vector>
+#include <limits>
+#include <atomic>
+#include <stdexcept>
+#include <cmath>
+#include "csrGraph.hpp"
+#include "parallel.hpp"
+using namespace std;
+
+template <typename T>
+class DeltaStepping {
+    private:
+        // entries of buckets further ahead than this share slots
+        static const int    MAX_SLOTS = 1 << 16;
+
+        const CSRGraph<T>&  graph;
+        int                 threads;
+        double              delta;          // width of one bucket
+        double              maxWeight;      // heaviest edge, for sizing the buckets
+        double              meanWeight;     // default delta
+
+        // state of one run, kept so the next run doesn't reallocate
+        vector<atomic<double> > dist;       // lowered with compare-and-swap by any thread
+        vector<vector<int> > buckets;       // circular; bucket b lives at b % buckets.size()
+        long long           pending;        // entries in buckets, stale ones included
+        long long           current;        // bucket being emptied
+        vector<int>         frontier;       // nodes to relax in the next phase
+        vector<int>         settledHere;    // nodes taken from the current bucket
+        vector<unsigned>    frontierMark;   // frontierMark[u] == frontierStamp while u is in frontier
+        vector<unsigned>    settledMark;    // settledMark[u] == settledStamp while u is in settledHere
+        unsigned            frontierStamp;
+        unsigned            settledStamp;
+        vector<vector<int> > improved;      // nodes each thread lowered during a phase
+        bool                heavyPhase;     // relaxing heavy edges of settledHere, not light ones of frontier
+        atomic<int>         next;           // next unclaimed position in the phase's work list
+        int                 phases;
+
+        long long bucketFor(double distance) const {
+            return static_cast<long long>(distance / delta);
+        }
+
+        static void newStamp(unsigned& stamp, vector<unsigned>& marks);
+        void        relaxPhase(int thread);
+        bool        takeBucket();
+        bool        advance();
+
+    public:
+                    DeltaStepping(const CSRGraph<T>& graph, int threads = 0);
+        void        setDelta(double delta);
+        int         run(int source, vector<double>& distances);
+
+        // getter functions
+        double      getDelta() const { return delta; }
+        int         getThreads() const { return threads; }
+        int         lastPhaseCount() const { return phases; }
+};
+
+#endif
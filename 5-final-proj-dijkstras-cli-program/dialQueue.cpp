@@ -0,0 +1,228 @@
+//=========================================================
+// DialQueue.cpp
+// Andrew McCutchan, Namu Kim
+// Implementaiton file for DialQueue class
+// 12/18/2024
+//=========================================================
+
+#include "dialQueue.hpp"
+
+//==============================================================
+// Constructor
+// INPUTS: Bucket width
+// OUTPUTS: NONE
+// Creates an empty queue. With integer weights and a width of 1
+// every bucket holds a single distance, as in Dial's algorithm.
+//==============================================================
+DialQueue::DialQueue(double width) {
+    buckets.resize(64);
+    current = 0;
+    count = 0;
+    setWidth(width);
+}
+
+//==============================================================
+// setWidth
+// INPUTS: Bucket width
+// OUTPUTS: NONE
+// Empties the queue and changes the bucket width
+//==============================================================
+void DialQueue::setWidth(double width) {
+    if (!(width > 0) || isinf(width)) {
+        throw invalid_argument("Bucket width must be positive");
+    }
+    clear();
+    this->width = width;
+}
+
+//==============================================================
+// resize
+// INPUTS: Number of handles
+// OUTPUTS: NONE
+// Empties the queue and makes room for handles 0..n-1
+//==============================================================
+void DialQueue::resize(int n) {
+    clear();
+    if (static_cast<int>(queued.size()) != n) {
+        priorities.assign(n, 0);
+        queued.assign(n, 0);
+    }
+}
+
+//==============================================================
+// clear
+// INPUTS: NONE
+// OUTPUTS: NONE
+// Empties the queue in time proportional to its entries and starts
+// accepting any non-negative priority again
+//==============================================================
+void DialQueue::clear() {
+    for (vector<pair<double, int> >& slots : buckets) {
+        for (const pair<double, int>& entry : slots) {
+            queued[entry.second] = 0;
+        }
+        slots.clear();
+    }
+    current = 0;
+    count = 0;
+}
+
+//==============================================================
+// makeRoom
+// INPUTS: Absolute bucket about to be used
+// OUTPUTS: NONE
+// Grows the circular array when the bucket is a full lap or more
+// ahead of the current one. The array only has to span the
+// largest edge weight, so this stops happening after warm-up.
+//==============================================================
+void DialQueue::makeRoom(long long bucket) {
+    long long span = bucket - current + 1;
+    if (span <= static_cast<long long>(buckets.size())) {
+        return;
+    }
+
+    size_t newSize = buckets.size();
+    while (static_cast<long long>(newSize) < 2 * span) {
+        newSize *= 2;
+    }
+    vector<vector<pair<double, int> > > old(newSize);
+    old.swap(buckets);
+    for (vector<pair<double, int> >& slots : old) {
+        for (const pair<double, int>& entry : slots) {
+            if (live(entry)) {
+                buckets[bucketFor(entry.first) % newSize].push_back(entry);
+            }
+        }
+    }
+}
+
+//==============================================================
+// checkPriority
+// INPUTS: Priority
+// OUTPUTS: NONE
+// Throws if the priority is negative, infinite, NaN, or in a
+// bucket before the current one, since the queue only moves
+// forward
+//==============================================================
+void DialQueue::checkPriority(double priority) const {
+    if (!(priority >= 0) || isinf(priority)) {
+        throw invalid_argument("Bucket queue priorities must be finite and non-negative");
+    }
+    if (bucketFor(priority) < current) {
+        throw invalid_argument("Bucket queue priorities must not go below the last extracted one");
+    }
+}
+
+//==============================================================
+// Insert
+// INPUTS: Handle and its priority
+// OUTPUTS: NONE
+// Inserts a handle
+//==============================================================
+void DialQueue::insert(int handle, double priority) {
+    if (handle < 0) {
+        throw invalid_argument("Handle must not be negative");
+    }
+    if (handle >= static_cast<int>(queued.size())) {
+        priorities.resize(handle + 1, 0);
+        queued.resize(handle + 1, 0);
+    }
+    if (queued[handle]) {
+        throw runtime_error("Node already exists in priority queue");
+    }
+
+    checkPriority(priority);
+    priorities[handle] = priority;
+    queued[handle] = 1;
+    place(handle, priority);
+    count++;
+}
+
+//==============================================================
+// findMin
+// INPUTS: Whether to take the handle out of its bucket
+// OUTPUTS: Handle with the smallest priority
+// Moves current forward to the first bucket with a live entry and
+// scans it, so priorities within a bucket still come out in order.
+// Stale entries met on the way are dropped.
+//==============================================================
+int DialQueue::findMin(bool take) {
+    while (true) {
+        vector<pair<double, int> >& slots = buckets[current % buckets.size()];
+        int best = -1;
+        size_t i = 0;
+        while (i < slots.size()) {
+            if (!live(slots[i])) {
+                slots[i] = slots.back();
+                slots.pop_back();
+                continue;
+            }
+            if (best == -1 || slots[i].first < slots[best].first) {
+                best = i;
+            }
+            i++;
+        }
+
+        if (best != -1) {
+            int handle = slots[best].second;
+            if (take) {
+                slots[best] = slots.back();
+                slots.pop_back();
+            }
+            return handle;
+        }
+        current++;
+    }
+}
+
+//==============================================================
+// Extract Min
+// INPUTS: NONE
+// OUTPUTS: Pair with handle and priority
+// Takes the min value out of the queue and returns it
+//==============================================================
+pair<int, double> DialQueue::extractMin() {
+    if (isEmpty()) {
+        throw runtime_error("Priority queue is empty");
+    }
+
+    int handle = findMin(true);
+    queued[handle] = 0;
+    count--;
+    return make_pair(handle, priorities[handle]);
+}
+
+//==============================================================
+// Peek Min
+// INPUTS: NONE
+// OUTPUTS: Pair with handle and priority
+// Returns the min value without taking it out of the queue
+//==============================================================
+pair<int, double> DialQueue::peekMin() {
+    if (isEmpty()) {
+        throw runtime_error("Priority queue is empty");
+    }
+
+    int handle = findMin(false);
+    return make_pair(handle, priorities[handle]);
+}
+
+//==============================================================
+// Decrease Key
+// INPUTS: Handle to change, its new priority
+// OUTPUTS: NONE
+// Lowers the priority of a queued handle by adding an entry in
+// the bucket of its new priority; a higher priority is ignored
+//==============================================================
+void DialQueue::decreaseKey(int handle, double newPriority) {
+    if (!contains(handle)) {
+        throw runtime_error("Node not found in priority queue");
+    }
+    if (newPriority >= priorities[handle]) {
+        return;
+    }
+
+    checkPriority(newPriority);
+    priorities[handle] = newPriority;
+    place(handle, newPriority);
+}
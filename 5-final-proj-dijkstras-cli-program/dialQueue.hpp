@@ -0,0 +1,69 @@
+//=========================================================
+// DialQueue.hpp
+// Andrew McCutchan, Namu Kim
+// Header file containing all function delcarations for
+// DialQueue class. A bucket queue (Dial's algorithm) over
+// dense integer handles: priorities are quantized into
+// buckets of a fixed width held in a circular array, for
+// searches whose extracted priorities never decrease.
+// 12/18/2024
+//=========================================================
+
+#ifndef DIAL_QUEUE_HPP
+#define DIAL_QUEUE_HPP
+
+#include <iostream>
+#include <vector>
+#include <utility>
+#include <stdexcept>
+#include <cmath>
+using namespace std;
+
+class DialQueue {
+    private:
+        double              width;          // range of priorities in one bucket
+
+        // entries carry their priority so scanning a bucket never looks
+        // a handle up; decreaseKey adds a new entry and the old one is
+        // dropped when it turns up (its priority is stale)
+        vector<vector<pair<double, int> > > buckets;   // circular; bucket b lives at b % buckets.size()
+        vector<double>      priorities;     // priority of each handle
+        vector<char>        queued;         // whether each handle is in the queue
+        long long           current;        // absolute bucket of the last extracted handle
+        int                 count;
+
+        long long bucketFor(double priority) const {
+            return static_cast<long long>(floor(priority / width));
+        }
+
+        bool live(const pair<double, int>& entry) const {
+            return queued[entry.second] && priorities[entry.second] == entry.first;
+        }
+
+        void place(int handle, double priority) {
+            long long bucket = bucketFor(priority);
+            makeRoom(bucket);
+            buckets[bucket % buckets.size()].push_back(make_pair(priority, handle));
+        }
+
+        void    checkPriority(double priority) const;
+        void    makeRoom(long long bucket);
+        int     findMin(bool take);
+
+    public:
+                            DialQueue(double width = 1.0);
+        void                resize(int n);
+        void                setWidth(double width);
+        void                insert(int handle, double priority);
+        pair<int, double>   extractMin();
+        pair<int, double>   peekMin();
+        void                decreaseKey(int handle, double newPriority);
+        void                clear();
+
+        bool                isEmpty() const { return count == 0; }
+        bool                contains(int handle) const { return handle < static_cast<int>(queued.size()) && queued[handle]; }
+        int                 size() const { return count; }
+        double              bucketWidth() const { return width; }
+};
+
+#endif
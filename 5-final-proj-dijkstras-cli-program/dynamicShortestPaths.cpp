@@ -0,0 +1,343 @@
+//=========================================================
+// DynamicShortestPaths.cpp
+// Andrew McCutchan, Namu Kim
+// Implementaiton file for DynamicShortestPaths class
+// 12/18/2024
+//=========================================================
+
+#include "dynamicShortestPaths.hpp"
+
+//==============================================================
+// Constructor
+// INPUTS: Frozen graph to copy the edges of
+// OUTPUTS: NONE
+// Copies the forward edges and builds in-edge lists that point
+// at them, so a weight only ever lives in one place
+//==============================================================
+template <class T>
+DynamicShortestPaths<T>::DynamicShortestPaths(const CSRGraph<T>& graph) {
+    int n = graph.numNodes();
+    int m = graph.numEdges();
+    ids.resize(n);
+    offsets.resize(n + 1);
+    targets.resize(m);
+    weights.resize(m);
+    sources.resize(m);
+    rOffsets.assign(n + 1, 0);
+    rEdges.resize(m);
+
+    for (int u = 0; u < n; u++) {
+        ids[u] = graph.nodeId(u);
+        offsets[u] = graph.edgeBegin(u);
+        for (int e = graph.edgeBegin(u); e < graph.edgeEnd(u); e++) {
+            targets[e] = graph.target(e);
+            weights[e] = graph.weight(e);
+            sources[e] = u;
+            rOffsets[targets[e] + 1]++;
+        }
+    }
+    offsets[n] = m;
+    byId.resize(n);
+    for (int u = 0; u < n; u++) {
+        byId[u] = make_pair(ids[u], u);
+    }
+    sort(byId.begin(), byId.end());
+    for (int v = 0; v < n; v++) {
+        rOffsets[v + 1] += rOffsets[v];
+    }
+    vector<int> next(rOffsets.begin(), rOffsets.end() - 1);
+    for (int e = 0; e < m; e++) {
+        rEdges[next[targets[e]]++] = e;
+    }
+
+    queue.resize(n);
+    mark.assign(n, 0);
+    generation = 0;
+    work = 0;
+}
+
+//==============================================================
+// denseId
+// INPUTS: Node ID
+// OUTPUTS: Dense index of the node
+//==============================================================
+template <class T>
+int DynamicShortestPaths<T>::denseId(const T& id) const {
+    typename vector<pair<T, int> >::const_iterator found = lower_bound(byId.begin(), byId.end(), make_pair(id, -1));
+    if (found == byId.end() || found->first != id) {
+        throw invalid_argument("Node not found in graph");
+    }
+    return found->second;
+}
+
+//==============================================================
+// findEdge
+// INPUTS: Dense tail and head indices
+// OUTPUTS: Index of the edge between them
+//==============================================================
+template <class T>
+int DynamicShortestPaths<T>::findEdge(int u, int v) const {
+    for (int e = offsets[u]; e < offsets[u + 1]; e++) {
+        if (targets[e] == v) {
+            return e;
+        }
+    }
+    throw invalid_argument("Edge not found in graph");
+}
+
+//==============================================================
+// treeOf
+// INPUTS: Source node ID
+// OUTPUTS: Tree of the pinned source
+//==============================================================
+template <class T>
+const typename DynamicShortestPaths<T>::Tree& DynamicShortestPaths<T>::treeOf(const T& source) const {
+    for (const Tree& tree : trees) {
+        if (tree.source == source) {
+            return tree;
+        }
+    }
+    throw invalid_argument("Source is not pinned");
+}
+
+//==============================================================
+// settle
+// INPUTS: Tree to repair, whether only affected nodes may change
+// OUTPUTS: NONE
+// Runs Dijkstra from whatever is in the queue. After a weight
+// rise only the affected subtree can improve; after a fall any
+// node can.
+//==============================================================
+template <class T>
+void DynamicShortestPaths<T>::settle(Tree& tree, bool onlyAffected) {
+    while (!queue.isEmpty()) {
+        auto [x, d] = queue.extractMin();
+        work++;
+        for (int e = offsets[x]; e < offsets[x + 1]; e++) {
+            int y = targets[e];
+            double newDist = d + weights[e];
+            if (newDist < tree.dist[y] && (!onlyAffected || mark[y] == generation)) {
+                tree.dist[y] = newDist;
+                tree.parent[y] = x;
+                if (queue.contains(y)) {
+                    queue.decreaseKey(y, newDist);
+                }
+                else {
+                    queue.insert(y, newDist);
+                }
+            }
+        }
+    }
+}
+
+//==============================================================
+// fullSearch
+// INPUTS: Tree with its source set
+// OUTPUTS: NONE
+// Builds the whole tree from scratch with the current weights
+//==============================================================
+template <class T>
+void DynamicShortestPaths<T>::fullSearch(Tree& tree) {
+    int root = denseId(tree.source);
+    tree.dist.assign(ids.size(), numeric_limits<double>::infinity());
+    tree.parent.assign(ids.size(), -1);
+    tree.dist[root] = 0;
+    queue.clear();
+    queue.insert(root, 0);
+    settle(tree, false);
+}
+
+//==============================================================
+// weightDecreased
+// INPUTS: Tree, edge whose weight went down
+// OUTPUTS: NONE
+// If the edge now gives its head a shorter path, the improvement
+// spreads from the head to exactly the nodes it shortens
+//==============================================================
+template <class T>
+void DynamicShortestPaths<T>::weightDecreased(Tree& tree, int e) {
+    int u = sources[e];
+    int v = targets[e];
+    double newDist = tree.dist[u] + weights[e];
+    if (!(newDist < tree.dist[v])) {
+        return;
+    }
+
+    tree.dist[v] = newDist;
+    tree.parent[v] = u;
+    queue.clear();
+    queue.insert(v, newDist);
+    settle(tree, false);
+}
+
+//==============================================================
+// weightIncreased
+// INPUTS: Tree, edge whose weight went up
+// OUTPUTS: NONE
+// Only matters if the edge is in the tree. Then the head's subtree
+// is the only part whose distances can change: each of its nodes
+// restarts from its best in-edge from outside the subtree, and
+// Dijkstra restricted to the subtree settles the rest.
+//==============================================================
+template <class T>
+void DynamicShortestPaths<T>::weightIncreased(Tree& tree, int e) {
+    int u = sources[e];
+    int v = targets[e];
+    if (tree.parent[v] != u) {
+        return;
+    }
+
+    generation++;
+    if (generation == 0) {
+        fill(mark.begin(), mark.end(), 0);
+        generation = 1;
+    }
+    affected.clear();
+    affected.push_back(v);
+    mark[v] = generation;
+    for (size_t i = 0; i < affected.size(); i++) {
+        int x = affected[i];
+        for (int f = offsets[x]; f < offsets[x + 1]; f++) {
+            int y = targets[f];
+            if (tree.parent[y] == x && mark[y] != generation) {
+                mark[y] = generation;
+                affected.push_back(y);
+            }
+        }
+    }
+
+    queue.clear();
+    for (int x : affected) {
+        work++;
+        double best = numeric_limits<double>::infinity();
+        int bestParent = -1;
+        for (int r = rOffsets[x]; r < rOffsets[x + 1]; r++) {
+            int f = rEdges[r];
+            int y = sources[f];
+            if (mark[y] != generation && tree.dist[y] + weights[f] < best) {
+                best = tree.dist[y] + weights[f];
+                bestParent = y;
+            }
+        }
+        tree.dist[x] = best;
+        tree.parent[x] = bestParent;
+        if (bestParent != -1) {
+            queue.insert(x, best);
+        }
+    }
+    settle(tree, true);
+}
+
+//==============================================================
+// pin
+// INPUTS: Source node ID
+// OUTPUTS: NONE
+// Builds the source's shortest path tree and keeps it up to date
+// from now on; pinning a source twice does nothing
+//==============================================================
+template <class T>
+void DynamicShortestPaths<T>::pin(const T& source) {
+    if (isPinned(source)) {
+        return;
+    }
+    Tree tree;
+    tree.source = source;
+    fullSearch(tree);
+    trees.push_back(move(tree));
+}
+
+//==============================================================
+// unpin
+// INPUTS: Source node ID
+// OUTPUTS: NONE
+// Stops keeping the source's tree
+//==============================================================
+template <class T>
+void DynamicShortestPaths<T>::unpin(const T& source) {
+    for (size_t i = 0; i < trees.size(); i++) {
+        if (trees[i].source == source) {
+            trees.erase(trees.begin() + i);
+            return;
+        }
+    }
+}
+
+//==============================================================
+// isPinned
+// INPUTS: Source node ID
+// OUTPUTS: Whether the source's tree is kept
+//==============================================================
+template <class T>
+bool DynamicShortestPaths<T>::isPinned(const T& source) const {
+    for (const Tree& tree : trees) {
+        if (tree.source == source) {
+            return true;
+        }
+    }
+    return false;
+}
+
+//==============================================================
+// setWeight
+// INPUTS: Tail and head node IDs of an existing edge, new weight
+// OUTPUTS: Old weight of the edge
+// Changes the weight and repairs every pinned tree. The cost
+// depends on how much of each tree the change touches, which
+// lastUpdateWork() reports. New edges are not supported: build a
+// new DynamicShortestPaths from the refrozen graph for those.
+//==============================================================
+template <class T>
+double DynamicShortestPaths<T>::setWeight(const T& u, const T& v, double weight) {
+    if (!(weight >= 0)) {
+        throw invalid_argument("Edge weights must be non-negative");
+    }
+    int e = findEdge(denseId(u), denseId(v));
+    double old = weights[e];
+    weights[e] = weight;
+    work = 0;
+
+    for (Tree& tree : trees) {
+        if (weight < old) {
+            weightDecreased(tree, e);
+        }
+        else if (weight > old) {
+            weightIncreased(tree, e);
+        }
+    }
+    return old;
+}
+
+//==============================================================
+// distance
+// INPUTS: Pinned source and any target node ID
+// OUTPUTS: Current shortest distance, infinity if unreachable
+//==============================================================
+template <class T>
+double DynamicShortestPaths<T>::distance(const T& source, const T& target) const {
+    return treeOf(source).dist[denseId(target)];
+}
+
+//==============================================================
+// path
+// INPUTS: Pinned source and any target node ID
+// OUTPUTS: Node IDs on the current shortest path, empty if the
+//          target is unreachable
+//==============================================================
+template <class T>
+vector<T> DynamicShortestPaths<T>::path(const T& source, const T& target) const {
+    const Tree& tree = treeOf(source);
+    vector<T> nodes;
+    int v = denseId(target);
+    if (tree.dist[v] == numeric_limits<double>::infinity()) {
+        return nodes;
+    }
+    for (int u = v; u != -1; u = tree.parent[u]) {
+        nodes.push_back(ids[u]);
+    }
+    reverse(nodes.begin(), nodes.end());
+    return nodes;
+}
+
+template class DynamicShortestPaths<long>;
+template class DynamicShortestPaths<long long>;
+template class DynamicShortestPaths<int>;
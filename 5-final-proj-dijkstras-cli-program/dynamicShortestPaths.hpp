@@ -0,0 +1,74 @@
+//=========================================================
+// DynamicShortestPaths.hpp
+// Andrew McCutchan, Namu Kim
+// Header file containing all function delcarations for
+// DynamicShortestPaths class. Keeps the shortest path trees
+// of a set of pinned sources up to date as edge weights
+// change, repairing only the part of each tree the change
+// affects (after Ramalingam and Reps).
+// 12/18/2024
+//=========================================================
+
+#ifndef DYNAMIC_SHORTEST_PATHS_HPP
+#define DYNAMIC_SHORTEST_PATHS_HPP
+
+#include <vector>
+#include <limits>
+#include <stdexcept>
+#include <algorithm>
+#include "csrGraph.hpp"
+#include "indexedPriorityQueue.hpp"
+using namespace std;
+
+template <typename T>
+class DynamicShortestPaths {
+    private:
+        // shortest path tree of one pinned source
+        struct Tree {
+            T               source;
+            vector<double>  dist;       // distance of every node, infinity if unreachable
+            vector<int>     parent;     // previous node on its shortest path, -1 for none
+        };
+
+        // own copy of the edges so weights can change without
+        // touching (or rebuilding) the frozen graph
+        vector<T>           ids;        // dense index -> node ID
+        vector<pair<T, int> > byId;     // (node ID, dense index), sorted by ID
+        vector<int>         offsets;    // out-edges of u are [offsets[u], offsets[u + 1])
+        vector<int>         targets;
+        vector<double>      weights;
+        vector<int>         rOffsets;   // in-edges of v are [rOffsets[v], rOffsets[v + 1])
+        vector<int>         rEdges;     // forward edge index of each in-edge
+        vector<int>         sources;    // tail of each forward edge
+
+        vector<Tree>        trees;
+        IndexedPriorityQueue<> queue;   // shared by every repair
+        vector<unsigned>    mark;       // mark[u] == generation while u is in the affected subtree
+        unsigned            generation;
+        vector<int>         affected;   // scratch list of the affected subtree
+        long long           work;       // nodes scanned or settled by the last update
+
+        int                 denseId(const T& id) const;
+        int                 findEdge(int u, int v) const;
+        const Tree&         treeOf(const T& source) const;
+        void                settle(Tree& tree, bool onlyAffected);
+        void                fullSearch(Tree& tree);
+        void                weightDecreased(Tree& tree, int e);
+        void                weightIncreased(Tree& tree, int e);
+
+    public:
+                            DynamicShortestPaths(const CSRGraph<T>& graph);
+        void                pin(const T& source);
+        void                unpin(const T& source);
+        double              setWeight(const T& u, const T& v, double weight);
+        double              distance(const T& source, const T& target) const;
+        vector<T>           path(const T& source, const T& target) const;
+
+        // getter functions
+        bool                isPinned(const T& source) const;
+        int                 pinnedCount() const { return trees.size(); }
+        double              edgeWeight(const T& u, const T& v) const { return weights[findEdge(denseId(u), denseId(v))]; }
+        long long           lastUpdateWork() const { return work; }
+};
+
+#endif
@@ -0,0 +1,92 @@
+//=========================================================
+// FlatArray.hpp
+// Andrew McCutchan, Namu Kim
+// Header file containing the FlatArray class. A FlatArray is
+// a read-only array that either owns its elements (in a
+// vector) or points at elements owned by someone else, such
+// as a memory-mapped graph file, so the same search code can
+// run over both.
+// 12/18/2024
+//=========================================================
+
+#ifndef FLAT_ARRAY_HPP
+#define FLAT_ARRAY_HPP
+
+#include <vector>
+#include <utility>
+using namespace std;
+
+template <typename X>
+class FlatArray {
+    private:
+        vector<X>   storage;    // elements when the array owns them
+        const X*    items;      // first element, in storage or elsewhere
+        size_t      count;
+        bool        owned;
+
+    public:
+        FlatArray() : items(nullptr), count(0), owned(true) {}
+
+        FlatArray(const FlatArray& other) : storage(other.storage), count(other.count), owned(other.owned) {
+            items = owned ? storage.data() : other.items;
+        }
+
+        FlatArray& operator=(const FlatArray& other) {
+            if (this != &other) {
+                storage = other.storage;
+                count = other.count;
+                owned = other.owned;
+                items = owned ? storage.data() : other.items;
+            }
+            return *this;
+        }
+
+        // moving keeps owned elements where they are in memory, so
+        // items can point at them again without copying anything
+        FlatArray(FlatArray&& other) noexcept : storage(move(other.storage)), count(other.count), owned(other.owned) {
+            items = owned ? storage.data() : other.items;
+            other.items = nullptr;
+            other.count = 0;
+            other.owned = true;
+        }
+
+        FlatArray& operator=(FlatArray&& other) noexcept {
+            if (this != &other) {
+                storage = move(other.storage);
+                count = other.count;
+                owned = other.owned;
+                items = owned ? storage.data() : other.items;
+                other.storage.clear();
+                other.items = nullptr;
+                other.count = 0;
+                other.owned = true;
+            }
+            return *this;
+        }
+
+        // take ownership of the elements of a vector
+        void assign(vector<X>&& elements) {
+            storage = move(elements);
+            items = storage.data();
+            count = storage.size();
+            owned = true;
+        }
+
+        // point at elements that outlive this array
+        void view(const X* elements, size_t n) {
+            storage.clear();
+            storage.shrink_to_fit();
+            items = elements;
+            count = n;
+            owned = false;
+        }
+
+        const X&    operator[](size_t i) const { return items[i]; }
+        const X*    data() const { return items; }
+        const X*    begin() const { return items; }
+        const X*    end() const { return items + count; }
+        size_t      size() const { return count; }
+        bool        isOwned() const { return owned; }
+};
+
+#endif
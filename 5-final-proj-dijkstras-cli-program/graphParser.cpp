@@ -0,0 +1,198 @@
+//=========================================================
+// GraphParser.cpp
+// Andrew McCutchan, Namu Kim
+// Implementaiton file for GraphParser class
+// 12/18/2024
+//=========================================================
+
+#include "graphParser.hpp"
+
+//==============================================================
+// Constructor
+// INPUTS: File name
+// OUTPUTS: NONE
+// Maps the file into memory and starts at its first line
+//==============================================================
+GraphParser::GraphParser(const string& filename) {
+    mapping = make_shared<MappedFile>(filename);
+    cursor = mapping->data();
+    end = cursor + mapping->size();
+    lineNumber = 1;
+}
+
+//==============================================================
+// Constructor
+// INPUTS: Input stream
+// OUTPUTS: NONE
+// Reads the rest of the stream into one buffer and starts at its
+// first line
+//==============================================================
+GraphParser::GraphParser(istream& in) {
+    buffer.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+    cursor = buffer.data();
+    end = cursor + buffer.size();
+    lineNumber = 1;
+}
+
+//==============================================================
+// Constructor
+// INPUTS: Range of characters owned by someone else and the line
+//         number the range starts on
+// OUTPUTS: NONE
+// Parses part of a buffer, such as one chunk of the edge section
+// handed to a worker thread. The range must outlive the parser.
+//==============================================================
+GraphParser::GraphParser(const char* first, const char* last, int firstLine) {
+    cursor = first;
+    end = last;
+    lineNumber = firstLine;
+}
+
+//==============================================================
+// fail
+// INPUTS: Description of the problem
+// OUTPUTS: NONE
+// Throws a parse_exception for the current line
+//==============================================================
+void GraphParser::fail(const string& message) const {
+    throw parse_exception(lineNumber, message);
+}
+
+//==============================================================
+// skipSpaces
+// INPUTS: NONE
+// OUTPUTS: NONE
+// Moves past spaces, tabs and carriage returns, but not newlines
+//==============================================================
+void GraphParser::skipSpaces() {
+    while (cursor < end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r')) {
+        cursor++;
+    }
+}
+
+//==============================================================
+// nextField
+// INPUTS: Name of the field, for error messages
+// OUTPUTS: Characters of the next whitespace separated field on
+//          the current line
+//==============================================================
+string_view GraphParser::nextField(const char* field) {
+    skipSpaces();
+    const char* start = cursor;
+    while (cursor < end && *cursor != ' ' && *cursor != '\t' && *cursor != '\r' && *cursor != '\n') {
+        cursor++;
+    }
+    if (start == cursor) {
+        fail(string("missing ") + field);
+    }
+    return string_view(start, cursor - start);
+}
+
+//==============================================================
+// readInteger
+// INPUTS: Name of the field, for error messages
+// OUTPUTS: Next field of the current line as an integer
+//==============================================================
+template <typename T>
+T GraphParser::readInteger(const char* field) {
+    string_view text = nextField(field);
+    const char* first = text.data();
+    const char* last = first + text.size();
+    if (*first == '+') {
+        first++;
+    }
+
+    T value;
+    from_chars_result result = from_chars(first, last, value);
+    if (result.ec == errc::result_out_of_range) {
+        fail(string(field) + " '" + string(text) + "' is out of range");
+    }
+    if (result.ec != errc() || result.ptr != last) {
+        fail(string(field) + " '" + string(text) + "' is not an integer");
+    }
+    return value;
+}
+
+//==============================================================
+// readDouble
+// INPUTS: Name of the field, for error messages
+// OUTPUTS: Next field of the current line as a double
+//==============================================================
+double GraphParser::readDouble(const char* field) {
+    string_view text = nextField(field);
+    const char* first = text.data();
+    const char* last = first + text.size();
+    if (*first == '+') {
+        first++;
+    }
+
+    double value;
+    from_chars_result result = from_chars(first, last, value);
+    if (result.ec != errc() || result.ptr != last) {
+        fail(string(field) + " '" + string(text) + "' is not a number");
+    }
+    return value;
+}
+
+//==============================================================
+// readRest
+// INPUTS: NONE
+// OUTPUTS: Remaining text of the current line with surrounding
+//          whitespace removed, empty if there is none
+// Used for optional trailing fields such as street names, which
+// may contain spaces
+//==============================================================
+string_view GraphParser::readRest() {
+    skipSpaces();
+    const char* start = cursor;
+    while (cursor < end && *cursor != '\n') {
+        cursor++;
+    }
+    const char* last = cursor;
+    while (last > start && (last[-1] == ' ' || last[-1] == '\t' || last[-1] == '\r')) {
+        last--;
+    }
+    return string_view(start, last - start);
+}
+
+//==============================================================
+// endLine
+// INPUTS: NONE
+// OUTPUTS: NONE
+// Moves to the start of the next line, failing if anything other
+// than whitespace is left on the current one
+//==============================================================
+void GraphParser::endLine() {
+    skipSpaces();
+    if (cursor < end && *cursor != '\n') {
+        fail("unexpected text '" + string(readRest()) + "'");
+    }
+    if (cursor < end) {
+        cursor++;
+        lineNumber++;
+    }
+}
+
+//==============================================================
+// skipBlankLines
+// INPUTS: NONE
+// OUTPUTS: False if only whitespace is left in the input
+//==============================================================
+bool GraphParser::skipBlankLines() {
+    while (true) {
+        skipSpaces();
+        if (cursor == end) {
+            return false;
+        }
+        if (*cursor != '\n') {
+            return true;
+        }
+        cursor++;
+        lineNumber++;
+    }
+}
+
+// template instantiations
+template int GraphParser::readInteger<int>(const char* field);
+template long GraphParser::readInteger<long>(const char* field);
+template long long GraphParser::readInteger<long long>(const char* field);
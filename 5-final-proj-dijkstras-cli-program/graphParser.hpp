@@ -0,0 +1,62 @@
+//=========================================================
+// GraphParser.hpp
+// Andrew McCutchan, Namu Kim
+// Header file containing all function delcarations for
+// GraphParser class. A GraphParser walks a graph file held
+// in one buffer (or mapped into memory) field by field and
+// converts numbers with from_chars, without allocating.
+// 12/18/2024
+//=========================================================
+
+#ifndef GRAPH_PARSER_HPP
+#define GRAPH_PARSER_HPP
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <memory>
+#include <stdexcept>
+#include <charconv>
+#include <iterator>
+#include "mappedFile.hpp"
+using namespace std;
+
+// thrown for input that doesn't match the graph format; line is
+// the 1-based line the problem was found on
+class parse_exception : public runtime_error {
+public:
+    int line;
+    parse_exception(int line, const string& message)
+        : runtime_error("line " + to_string(line) + ": " + message), line(line) {}
+};
+
+class GraphParser {
+    private:
+        shared_ptr<MappedFile>  mapping;    // file being read, if constructed from a file name
+        string                  buffer;     // stream contents, if constructed from a stream
+        const char*             cursor;
+        const char*             end;
+        int                     lineNumber;
+
+        void            skipSpaces();
+        string_view     nextField(const char* field);
+        [[noreturn]] void fail(const string& message) const;
+
+    public:
+                        GraphParser(const string& filename);
+                        GraphParser(istream& in);
+                        GraphParser(const char* first, const char* last, int firstLine);
+        template <typename T>
+        T               readInteger(const char* field);
+        double          readDouble(const char* field);
+        string_view     readRest();
+        void            endLine();
+        bool            skipBlankLines();
+
+        // getter functions
+        int             line() const { return lineNumber; }
+        const char*     position() const { return cursor; }
+        const char*     inputEnd() const { return end; }
+};
+
+#endif
@@ -0,0 +1,173 @@
+//=========================================================
+// IndexedPriorityQueue.cpp
+// Andrew McCutchan, Namu Kim
+// Implementaiton file for IndexedPriorityQueue class
+// 12/18/2024
+//=========================================================
+
+#include "indexedPriorityQueue.hpp"
+
+//==============================================================
+// Default Constructor
+// INPUTS: NONE
+// OUTPUTS: NONE
+// Creates an empty queue with room for no handles; it grows on
+// insert or resize
+//==============================================================
+template <int Arity>
+IndexedPriorityQueue<Arity>::IndexedPriorityQueue() {}
+
+//==============================================================
+// Constructor
+// INPUTS: Number of handles
+// OUTPUTS: NONE
+// Creates an empty queue for handles 0..n-1
+//==============================================================
+template <int Arity>
+IndexedPriorityQueue<Arity>::IndexedPriorityQueue(int n) {
+    resize(n);
+}
+
+//==============================================================
+// resize
+// INPUTS: Number of handles
+// OUTPUTS: NONE
+// Empties the queue and makes room for handles 0..n-1. Keeps the
+// position array when its size is already right.
+//==============================================================
+template <int Arity>
+void IndexedPriorityQueue<Arity>::resize(int n) {
+    if (static_cast<int>(position.size()) != n) {
+        heap.clear();
+        priorities.clear();
+        position.assign(n, -1);
+    }
+    else {
+        clear();
+    }
+}
+
+//==============================================================
+// clear
+// INPUTS: NONE
+// OUTPUTS: NONE
+// Empties the queue in time proportional to its size, not to the
+// number of handles
+//==============================================================
+template <int Arity>
+void IndexedPriorityQueue<Arity>::clear() {
+    for (int handle : heap) {
+        position[handle] = -1;
+    }
+    heap.clear();
+    priorities.clear();
+}
+
+//==============================================================
+// Insert
+// INPUTS: Handle and its priority
+// OUTPUTS: NONE
+// Inserts a handle, growing the position array if the handle is
+// beyond it
+//==============================================================
+template <int Arity>
+void IndexedPriorityQueue<Arity>::insert(int handle, double priority) {
+    if (handle < 0) {
+        throw invalid_argument("Handle must not be negative");
+    }
+    if (handle >= static_cast<int>(position.size())) {
+        position.resize(handle + 1, -1);
+    }
+    if (position[handle] != -1) {
+        throw runtime_error("Node already exists in priority queue");
+    }
+
+    heap.push_back(handle);
+    priorities.push_back(priority);
+    heapifyUp(heap.size() - 1);
+}
+
+//==============================================================
+// Extract Min
+// INPUTS: NONE
+// OUTPUTS: Pair with handle and priority
+// Takes the min value out of the priority queue and returns it
+//==============================================================
+template <int Arity>
+pair<int, double> IndexedPriorityQueue<Arity>::extractMin() {
+    if (isEmpty()) {
+        throw runtime_error("Priority queue is empty");
+    }
+
+    pair<int, double> minElement = make_pair(heap[0], priorities[0]);
+    position[heap[0]] = -1;
+
+    heap[0] = heap.back();
+    priorities[0] = priorities.back();
+    heap.pop_back();
+    priorities.pop_back();
+
+    if (!isEmpty()) {
+        heapifyDown(0);
+    }
+    return minElement;
+}
+
+//==============================================================
+// Peek Min
+// INPUTS: NONE
+// OUTPUTS: Pair with handle and priority
+// Returns the min value without taking it out of the queue
+//==============================================================
+template <int Arity>
+pair<int, double> IndexedPriorityQueue<Arity>::peekMin() const {
+    if (isEmpty()) {
+        throw runtime_error("Priority queue is empty");
+    }
+    return make_pair(heap[0], priorities[0]);
+}
+
+//==============================================================
+// Decrease Key
+// INPUTS: Handle to change, its new priority
+// OUTPUTS: NONE
+// Lowers the priority of a queued handle; a higher priority is
+// ignored
+//==============================================================
+template <int Arity>
+void IndexedPriorityQueue<Arity>::decreaseKey(int handle, double newPriority) {
+    if (!contains(handle)) {
+        throw runtime_error("Node not found in priority queue");
+    }
+
+    int index = position[handle];
+    if (newPriority >= priorities[index]) {
+        return;
+    }
+
+    priorities[index] = newPriority;
+    heapifyUp(index);
+}
+
+//==============================================================
+// PrintMinHeap
+// INPUTS: NONE
+// OUTPUTS: NONE
+// Prints out the min PQ
+//==============================================================
+template <int Arity>
+void IndexedPriorityQueue<Arity>::printMinHeap() {
+    cout << "Priority Queue (Min-Heap):" << endl;
+    cout << "-----------------------------------" << endl;
+
+    for (size_t i = 0; i < heap.size(); ++i) {
+        cout << i << ": "
+             << heap[i] << ", "
+             << priorities[i] << endl;
+    }
+}
+
+// class instantiations
+template class IndexedPriorityQueue<2>;
+template class IndexedPriorityQueue<4>;
+template class IndexedPriorityQueue<8>;
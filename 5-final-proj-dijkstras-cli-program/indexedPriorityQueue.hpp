@@ -0,0 +1,96 @@
+//=========================================================
+// IndexedPriorityQueue.hpp
+// Andrew McCutchan, Namu Kim
+// Header file containing all function delcarations for
+// IndexedPriorityQueue class. A min-heap over dense integer
+// handles 0..n-1 (such as CSR node indices) that tracks each
+// handle's heap slot in a plain array instead of a hash map.
+// Arity is the number of children of each heap node.
+// 12/18/2024
+//=========================================================
+
+#ifndef INDEXED_PRIORITY_QUEUE_HPP
+#define INDEXED_PRIORITY_QUEUE_HPP
+
+#include <iostream>
+#include <vector>
+#include <utility>
+#include <stdexcept>
+using namespace std;
+
+template <int Arity = 2>
+class IndexedPriorityQueue {
+    static_assert(Arity >= 2, "a heap needs at least two children per node");
+
+    private:
+        vector<int>     heap;           // handle in each heap slot
+        vector<double>  priorities;     // priority of each heap slot
+        vector<int>     position;       // heap slot of each handle, -1 if not queued
+
+        // helpers for maintaining heap property when adding or deleting;
+        // the moving entry is held aside and written once at the end
+        void heapifyUp(int index) {
+            int handle = heap[index];
+            double priority = priorities[index];
+            while (index > 0) {
+                int parentIndex = (index - 1) / Arity;
+                if (priorities[parentIndex] <= priority) {
+                    break;
+                }
+                heap[index] = heap[parentIndex];
+                priorities[index] = priorities[parentIndex];
+                position[heap[index]] = index;
+                index = parentIndex;
+            }
+            heap[index] = handle;
+            priorities[index] = priority;
+            position[handle] = index;
+        }
+
+        void heapifyDown(int index) {
+            int size = heap.size();
+            int handle = heap[index];
+            double priority = priorities[index];
+            while (true) {
+                int firstChild = Arity * index + 1;
+                if (firstChild >= size) {
+                    break;
+                }
+                int lastChild = firstChild + Arity < size ? firstChild + Arity : size;
+                int smallest = firstChild;
+                for (int child = firstChild + 1; child < lastChild; child++) {
+                    if (priorities[child] < priorities[smallest]) {
+                        smallest = child;
+                    }
+                }
+                if (priorities[smallest] >= priority) {
+                    break;
+                }
+                heap[index] = heap[smallest];
+                priorities[index] = priorities[smallest];
+                position[heap[index]] = index;
+                index = smallest;
+            }
+            heap[index] = handle;
+            priorities[index] = priority;
+            position[handle] = index;
+        }
+
+    public:
+                            IndexedPriorityQueue();
+                            IndexedPriorityQueue(int n);
+        void                resize(int n);
+        void                insert(int handle, double priority);
+        pair<int, double>   extractMin();
+        pair<int, double>   peekMin() const;
+        void                decreaseKey(int handle, double newPriority);
+        void                printMinHeap();
+        void                clear();
+
+        bool                isEmpty() const { return heap.empty(); }
+        bool                contains(int handle) const { return handle < static_cast<int>(position.size()) && position[handle] != -1; }
+        int                 size() const { return heap.size(); }
+        int                 capacity() const { return position.size(); }
+};
+
+#endif
@@ -0,0 +1,270 @@
+//=========================================================
+// KShortestPaths.cpp
+// Andrew McCutchan, Namu Kim
+// Implementaiton file for KShortestPaths class
+// 12/18/2024
+//=========================================================
+
+#include "kShortestPaths.hpp"
+
+//==============================================================
+// Constructor
+// INPUTS: Frozen graph to search, number of threads (0 for one
+//         per core)
+// OUTPUTS: NONE
+// The graph must outlive this object and not change while it is
+// in use. The worker threads are started here and kept until the
+// object is destroyed.
+//==============================================================
+template <class T>
+KShortestPaths<T>::KShortestPaths(const CSRGraph<T>& graph, int threads) : graph(graph) {
+    this->threads = threadCount(threads);
+    states.resize(this->threads);
+    if (this->threads > 1) {
+        pool.reset(new WorkerPool(this->threads));
+    }
+}
+
+//==============================================================
+// newBans
+// INPUTS: Thread state
+// OUTPUTS: NONE
+// Lifts every ban in O(1) by moving to a new stamp
+//==============================================================
+template <class T>
+void KShortestPaths<T>::newBans(SpurState& state) {
+    state.stamp++;
+    if (state.stamp == 0) {
+        fill(state.bannedNode.begin(), state.bannedNode.end(), 0);
+        fill(state.bannedEdge.begin(), state.bannedEdge.end(), 0);
+        state.stamp = 1;
+    }
+}
+
+//==============================================================
+// findEdge
+// INPUTS: Dense tail and head indices
+// OUTPUTS: Index of the edge between them
+//==============================================================
+template <class T>
+int KShortestPaths<T>::findEdge(int u, int v) const {
+    for (int e = graph.edgeBegin(u); e < graph.edgeEnd(u); e++) {
+        if (graph.target(e) == v) {
+            return e;
+        }
+    }
+    return -1;
+}
+
+//==============================================================
+// distancesToTarget
+// INPUTS: Dense target index, workspace to search with
+// OUTPUTS: NONE
+// One Dijkstra search over the reversed edges. Removing edges and
+// nodes only makes paths longer, so these distances are a lower
+// bound for every spur search, and nodes that can't reach the
+// target at all are never explored.
+//==============================================================
+template <class T>
+void KShortestPaths<T>::distancesToTarget(int target, SearchWorkspace& ws) {
+    ws.reset(graph.numNodes());
+    ws.update(target, 0, -1);
+    ws.queue.insert(target, 0);
+    while (!ws.queue.isEmpty()) {
+        auto [current, currentDist] = ws.queue.extractMin();
+        for (int e = graph.reverseEdgeBegin(current); e < graph.reverseEdgeEnd(current); e++) {
+            int neighbor = graph.reverseSource(e);
+            double newDist = currentDist + graph.reverseWeight(e);
+            if (!ws.reached(neighbor)) {
+                ws.update(neighbor, newDist, current);
+                ws.queue.insert(neighbor, newDist);
+            }
+            else if (ws.distance(neighbor) > newDist) {
+                ws.update(neighbor, newDist, current);
+                ws.queue.decreaseKey(neighbor, newDist);
+            }
+        }
+    }
+
+    toTarget.resize(graph.numNodes());
+    for (int u = 0; u < graph.numNodes(); u++) {
+        toTarget[u] = ws.distance(u);
+    }
+}
+
+//==============================================================
+// spurSearch
+// INPUTS: Dense spur and target indices, largest weight worth
+//         finding from the spur, state with the bans set, path to
+//         write into
+// OUTPUTS: Whether a path under the bound was found
+// A* from the spur node guided by toTarget, skipping banned nodes
+// and edges. Anything whose lower bound reaches the bound is never
+// queued, so hopeless spurs stop almost at once.
+//==============================================================
+template <class T>
+bool KShortestPaths<T>::spurSearch(int spur, int target, double bound, SpurState& state, Candidate& found) const {
+    SearchWorkspace& ws = state.ws;
+    ws.reset(graph.numNodes());
+    if (!(toTarget[spur] < bound)) {
+        return false;
+    }
+    ws.update(spur, 0, -1);
+    ws.queue.insert(spur, toTarget[spur]);
+
+    while (!ws.queue.isEmpty()) {
+        int current = ws.queue.extractMin().first;
+        ws.settled++;
+        if (current == target) {
+            ws.path(target, found.nodes);
+            found.weight = ws.distance(target);
+            return true;
+        }
+
+        double currentDist = ws.distance(current);
+        for (int e = graph.edgeBegin(current); e < graph.edgeEnd(current); e++) {
+            int neighbor = graph.target(e);
+            if (state.bannedEdge[e] == state.stamp || state.bannedNode[neighbor] == state.stamp) {
+                continue;
+            }
+            double newDist = currentDist + graph.weight(e);
+            double estimate = newDist + toTarget[neighbor];
+            if (!(estimate < bound)) {
+                continue;
+            }
+            if (!ws.reached(neighbor)) {
+                ws.update(neighbor, newDist, current);
+                ws.queue.insert(neighbor, estimate);
+            }
+            else if (ws.distance(neighbor) > newDist && ws.queue.contains(neighbor)) {
+                ws.update(neighbor, newDist, current);
+                ws.queue.decreaseKey(neighbor, estimate);
+            }
+        }
+    }
+    return false;
+}
+
+//==============================================================
+// find
+// INPUTS: Dense source and target indices, number of paths
+// OUTPUTS: Up to k loopless paths from source to target, shortest
+//          first (fewer if the graph has fewer)
+// Yen's algorithm. Each round takes the last path found and, for
+// every node on it, searches for the best way to leave the shared
+// prefix there. Those spur searches are independent and are shared
+// out across the pool's threads when a round has enough of them. A
+// spur is skipped when its prefix weight plus the lower bound from
+// the spur can't beat the candidates already waiting, which is most
+// of them once a few candidates are known. For k = 1 there are no
+// spurs, so one plain Dijkstra search answers it without the
+// backward search.
+//==============================================================
+template <class T>
+vector<Route<T> > KShortestPaths<T>::find(int source, int target, int k) {
+    vector<Route<T> > routes;
+    if (k <= 0) {
+        return routes;
+    }
+    for (SpurState& state : states) {
+        if (static_cast<int>(state.bannedNode.size()) != graph.numNodes()) {
+            state.bannedNode.assign(graph.numNodes(), 0);
+            state.bannedEdge.assign(graph.numEdges(), 0);
+            state.stamp = 0;
+        }
+    }
+
+    vector<Candidate> accepted;
+    if (k == 1) {
+        Candidate best;
+        best.weight = graph.dijkstras(source, target, states[0].ws);
+        if (best.weight != numeric_limits<double>::infinity()) {
+            states[0].ws.path(target, best.nodes);
+            accepted.push_back(best);
+        }
+    }
+    else {
+        distancesToTarget(target, states[0].ws);
+        Candidate first;
+        newBans(states[0]);
+        if (spurSearch(source, target, numeric_limits<double>::infinity(), states[0], first)) {
+            accepted.push_back(first);
+        }
+    }
+    vector<Candidate> waiting;      // candidates not yet accepted, kept sorted
+    while (!accepted.empty() && static_cast<int>(accepted.size()) < k) {
+        const vector<int>& last = accepted.back().nodes;
+        int spurs = last.size() - 1;
+        vector<double> prefixWeight(spurs + 1, 0);
+        for (int i = 0; i < spurs; i++) {
+            prefixWeight[i + 1] = prefixWeight[i] + graph.weight(findEdge(last[i], last[i + 1]));
+        }
+
+        // a spur only helps if it beats the candidate that would
+        // otherwise be accepted last
+        size_t needed = k - accepted.size();
+        double bound = waiting.size() >= needed ? waiting[needed - 1].weight : numeric_limits<double>::infinity();
+
+        vector<Candidate> found(spurs);
+        vector<char> foundAny(spurs, 0);
+        atomic<int> next(0);
+        auto work = [&](int t) {
+            SpurState& state = states[t];
+            for (int i = next++; i < spurs; i = next++) {
+                int spur = last[i];
+                if (!(prefixWeight[i] + toTarget[spur] < bound)) {
+                    continue;
+                }
+                newBans(state);
+                for (int j = 0; j < i; j++) {
+                    state.bannedNode[last[j]] = state.stamp;
+                }
+                for (const Candidate& path : accepted) {
+                    if (static_cast<int>(path.nodes.size()) > i + 1 && equal(last.begin(), last.begin() + i + 1, path.nodes.begin())) {
+                        state.bannedEdge[findEdge(path.nodes[i], path.nodes[i + 1])] = state.stamp;
+                    }
+                }
+
+                Candidate& spurPath = found[i];
+                if (spurSearch(spur, target, bound - prefixWeight[i], state, spurPath)) {
+                    spurPath.nodes.insert(spurPath.nodes.begin(), last.begin(), last.begin() + i);
+                    spurPath.weight += prefixWeight[i];
+                    foundAny[i] = 1;
+                }
+            }
+        };
+        if (!pool || spurs < MIN_PARALLEL_SPURS) {
+            work(0);
+        }
+        else {
+            pool->run(work);
+        }
+
+        for (int i = 0; i < spurs; i++) {
+            if (foundAny[i] && find_if(waiting.begin(), waiting.end(), [&](const Candidate& c) {
+                    return c.nodes == found[i].nodes; }) == waiting.end()) {
+                waiting.insert(upper_bound(waiting.begin(), waiting.end(), found[i]), found[i]);
+            }
+        }
+        if (waiting.empty()) {
+            break;
+        }
+        accepted.push_back(waiting.front());
+        waiting.erase(waiting.begin());
+    }
+
+    for (const Candidate& path : accepted) {
+        Route<T> route;
+        route.weight = path.weight;
+        for (int u : path.nodes) {
+            route.ids.push_back(graph.nodeId(u));
+            route.coords.push_back(graph.coord(u));
+        }
+        routes.push_back(route);
+    }
+    return routes;
+}
+
+template class KShortestPaths<long>;
+template class KShortestPaths<long long>;
+template class KShortestPaths<int>;
@@ -0,0 +1,64 @@
+//=========================================================
+// KShortestPaths.hpp
+// Andrew McCutchan, Namu Kim
+// Header file containing all function delcarations for
+// KShortestPaths class. Finds the k shortest loopless paths
+// between two nodes with Yen's algorithm, running the spur
+// searches of each round on a pool of threads.
+// 12/18/2024
+//=========================================================
+
+#ifndef K_SHORTEST_PATHS_HPP
+#define K_SHORTEST_PATHS_HPP
+
+#include <vector>
+#include <limits>
+#include <atomic>
+#include <algorithm>
+#include <memory>
+#include "csrGraph.hpp"
+#include "route.hpp"
+#include "parallel.hpp"
+using namespace std;
+
+template <typename T>
+class KShortestPaths {
+    private:
+        // rounds with fewer spurs than this run on the calling thread,
+        // since waking the pool would cost more than it saves
+        static const int        MIN_PARALLEL_SPURS = 8;
+
+        // search state owned by one thread, kept between queries
+        struct SpurState {
+            SearchWorkspace     ws;
+            vector<unsigned>    bannedNode;     // bannedNode[u] == stamp while u is banned
+            vector<unsigned>    bannedEdge;
+            unsigned            stamp = 0;
+        };
+
+        // a path as dense indices with its weight
+        struct Candidate {
+            vector<int>         nodes;
+            double              weight;
+            bool operator<(const Candidate& other) const {
+                return weight != other.weight ? weight < other.weight : nodes < other.nodes;
+            }
+        };
+
+        const CSRGraph<T>&      graph;
+        int                     threads;
+        vector<SpurState>       states;
+        unique_ptr<WorkerPool>  pool;       // started once, only with more than one thread
+        vector<double>          toTarget;   // exact distance from each node to the target
+
+        static void         newBans(SpurState& state);
+        int                 findEdge(int u, int v) const;
+        void                distancesToTarget(int target, SearchWorkspace& ws);
+        bool                spurSearch(int spur, int target, double bound, SpurState& state, Candidate& found) const;
+
+    public:
+                            KShortestPaths(const CSRGraph<T>& graph, int threads = 0);
+        vector<Route<T> >   find(int source, int target, int k);
+};
+
+#endif
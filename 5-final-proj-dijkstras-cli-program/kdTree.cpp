@@ -0,0 +1,166 @@
+//=========================================================
+// KDTree.cpp
+// Andrew McCutchan, Namu Kim
+// Implementaiton file for KDTree class
+// 12/18/2024
+//=========================================================
+
+#include "kdTree.hpp"
+
+//==============================================================
+// Default Constructor
+// INPUTS: NONE
+// OUTPUTS: NONE
+// Creates an empty tree
+//==============================================================
+KDTree::KDTree() {}
+
+//==============================================================
+// Constructor
+// INPUTS: Coordinates of every dense node index
+// OUTPUTS: NONE
+// Builds a balanced tree over all points in O(n log n). Points
+// with NaN coordinates (nodes that never had a vertex line) are
+// left out of the index.
+//==============================================================
+KDTree::KDTree(const vector<pair<double, double> >& points) {
+    vector<int> order;
+    for (size_t i = 0; i < points.size(); i++) {
+        if (!isnan(points[i].first) && !isnan(points[i].second)) {
+            order.push_back(i);
+        }
+    }
+
+    build(points, order, 0, order.size(), 0);
+
+    vector<double> x(order.size()), y(order.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        x[i] = points[order[i]].first;
+        y[i] = points[order[i]].second;
+    }
+    nodes.assign(move(order));
+    xs.assign(move(x));
+    ys.assign(move(y));
+}
+
+//==============================================================
+// Constructor
+// INPUTS: Slot arrays of an already built tree and their length
+// OUTPUTS: NONE
+// Wraps a tree laid out by another KDTree (for example one stored
+// in a memory-mapped graph file) without copying it. The arrays
+// must outlive the tree.
+//==============================================================
+KDTree::KDTree(const int* nodeData, const double* xData, const double* yData, int n) {
+    nodes.view(nodeData, n);
+    xs.view(xData, n);
+    ys.view(yData, n);
+}
+
+//==============================================================
+// build
+// INPUTS: Point list, node order being built, slot range [lo, hi)
+//         and depth
+// OUTPUTS: NONE
+// Places the median of the range (by x or y depending on depth)
+// at the middle slot and recurses on both halves
+//==============================================================
+void KDTree::build(const vector<pair<double, double> >& points, vector<int>& order, int lo, int hi, int depth) {
+    if (hi - lo <= 1) {
+        return;
+    }
+
+    int mid = (lo + hi) / 2;
+    bool byX = depth % 2 == 0;
+    nth_element(order.begin() + lo, order.begin() + mid, order.begin() + hi,
+                [&](int a, int b) {
+                    return byX ? points[a].first < points[b].first
+                               : points[a].second < points[b].second;
+                });
+
+    build(points, order, lo, mid, depth + 1);
+    build(points, order, mid + 1, hi, depth + 1);
+}
+
+//==============================================================
+// exact
+// INPUTS: Coordinate pair
+// OUTPUTS: Dense index of a node at exactly that coordinate, -1
+//          if there is none
+//==============================================================
+int KDTree::exact(pair<double, double> coord) const {
+    return exact(0, nodes.size(), 0, coord.first, coord.second);
+}
+
+int KDTree::exact(int lo, int hi, int depth, double x, double y) const {
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (xs[mid] == x && ys[mid] == y) {
+            return nodes[mid];
+        }
+
+        double key = depth % 2 == 0 ? x : y;
+        double split = depth % 2 == 0 ? xs[mid] : ys[mid];
+        if (key == split) {
+            // points equal to the split value can sit on either side
+            int found = exact(lo, mid, depth + 1, x, y);
+            if (found != -1) {
+                return found;
+            }
+            lo = mid + 1;
+        }
+        else if (key < split) {
+            hi = mid;
+        }
+        else {
+            lo = mid + 1;
+        }
+        depth++;
+    }
+    return -1;
+}
+
+//==============================================================
+// nearest
+// INPUTS: Coordinate pair
+// OUTPUTS: Dense index of the node closest to the coordinate
+//          (Euclidean distance in coordinate space), -1 if the
+//          tree is empty
+//==============================================================
+int KDTree::nearest(pair<double, double> coord) const {
+    int best = -1;
+    double bestDist = numeric_limits<double>::infinity();
+    nearest(0, nodes.size(), 0, coord.first, coord.second, best, bestDist);
+    return best;
+}
+
+void KDTree::nearest(int lo, int hi, int depth, double x, double y, int& best, double& bestDist) const {
+    if (lo >= hi) {
+        return;
+    }
+
+    int mid = (lo + hi) / 2;
+    double dx = xs[mid] - x;
+    double dy = ys[mid] - y;
+    double dist = dx * dx + dy * dy;
+    if (dist < bestDist) {
+        bestDist = dist;
+        best = nodes[mid];
+    }
+
+    // search the side holding the query first, then the other side
+    // only if the splitting line is closer than the best match
+    double diff = depth % 2 == 0 ? x - xs[mid] : y - ys[mid];
+    if (diff < 0) {
+        nearest(lo, mid, depth + 1, x, y, best, bestDist);
+        if (diff * diff < bestDist) {
+            nearest(mid + 1, hi, depth + 1, x, y, best, bestDist);
+        }
+    }
+    else {
+        nearest(mid + 1, hi, depth + 1, x, y, best, bestDist);
+        if (diff * diff < bestDist) {
+            nearest(lo, mid, depth + 1, x, y, best, bestDist);
+        }
+    }
+}
@@ -0,0 +1,47 @@
+//=========================================================
+// KDTree.hpp
+// Andrew McCutchan, Namu Kim
+// Header file containing all function delcarations for
+// KDTree class. A KDTree is a static 2-d tree over vertex
+// coordinates used to map a coordinate back to its node
+// (or to the closest node) without scanning every vertex.
+// 12/18/2024
+//=========================================================
+
+#ifndef KD_TREE_HPP
+#define KD_TREE_HPP
+
+#include <vector>
+#include <utility>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include "flatArray.hpp"
+using namespace std;
+
+class KDTree {
+    private:
+        // the tree is implicit: the subtree over [lo, hi) has its
+        // root at (lo + hi) / 2, split on x at even depths and y at odd
+        FlatArray<int>      nodes;  // dense node index stored at each slot
+        FlatArray<double>   xs;
+        FlatArray<double>   ys;
+
+        void    build(const vector<pair<double, double> >& points, vector<int>& order, int lo, int hi, int depth);
+        int     exact(int lo, int hi, int depth, double x, double y) const;
+        void    nearest(int lo, int hi, int depth, double x, double y, int& best, double& bestDist) const;
+
+    public:
+                KDTree();
+                KDTree(const vector<pair<double, double> >& points);
+                KDTree(const int* nodeData, const double* xData, const double* yData, int n);
+        int     exact(pair<double, double> coord) const;
+        int     nearest(pair<double, double> coord) const;
+
+        int     size() const { return nodes.size(); }
+        const int*      nodeData() const { return nodes.data(); }
+        const double*   xData() const { return xs.data(); }
+        const double*   yData() const { return ys.data(); }
+};
+
+#endif
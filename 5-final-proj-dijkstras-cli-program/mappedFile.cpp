@@ -0,0 +1,50 @@
+//=========================================================
+// MappedFile.cpp
+// Andrew McCutchan, Namu Kim
+// Implementaiton file for MappedFile class
+// 12/18/2024
+//=========================================================
+
+#include "mappedFile.hpp"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+//==============================================================
+// Constructor
+// INPUTS: File name
+// OUTPUTS: NONE
+// Maps the file read-only. Pages are only read from disk when
+// they are first touched.
+//==============================================================
+MappedFile::MappedFile(const string& filename) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd == -1) {
+        throw runtime_error("file not found");
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) == -1 || info.st_size == 0) {
+        close(fd);
+        throw runtime_error("cannot map an empty file");
+    }
+    length = info.st_size;
+
+    void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        throw runtime_error("could not map file");
+    }
+    bytes = static_cast<const char*>(mapped);
+}
+
+//==============================================================
+// Destructor
+// INPUTS: NONE
+// OUTPUTS: NONE
+// Unmaps the file
+//==============================================================
+MappedFile::~MappedFile() {
+    munmap(const_cast<char*>(bytes), length);
+}
@@ -0,0 +1,32 @@
+//=========================================================
+// MappedFile.hpp
+// Andrew McCutchan, Namu Kim
+// Header file containing all function delcarations for
+// MappedFile class. A MappedFile maps a whole file read-only
+// into memory and unmaps it when destroyed.
+// 12/18/2024
+//=========================================================
+
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <string>
+#include <stdexcept>
+using namespace std;
+
+class MappedFile {
+    private:
+        const char*     bytes;
+        size_t          length;
+
+    public:
+                        MappedFile(const string& filename);
+                        MappedFile(const MappedFile& other) = delete;
+                        ~MappedFile();
+        MappedFile&     operator=(const MappedFile& other) = delete;
+
+        const char*     data() const { return bytes; }
+        size_t          size() const { return length; }
+};
+
+#endif
@@ -5,8 +5,24 @@
 // 12/18/2024
 //=========================================================
 #include <iostream> 
+#include <chrono>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <charconv>
+#include <random>
 #include "weightedGraph.hpp"
 #include "priorityQueue.hpp"
+#include "indexedPriorityQueue.hpp"
+#include "pairingHeap.hpp"
+#include "radixHeap.hpp"
+#include "dialQueue.hpp"
+#include "routeServer.hpp"
+#include "dynamicShortestPaths.hpp"
+#include "compressedGraph.hpp"
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
 using namespace std;
 
 
@@ -26,6 +42,126 @@ void assertTest(bool condition) {
     }
 }
 
+// Counts every heap allocation in the program, so a test can check
+// that a code path allocates nothing, and the bytes asked for, so a
+// bench can weigh a data structure
+atomic<long long> allocations(0);
+atomic<long long> allocatedBytes(0);
+
+void* operator new(size_t size) {
+    allocations++;
+    allocatedBytes += size;
+    void* memory = malloc(size > 0 ? size : 1);
+    if (memory == nullptr) {
+        throw bad_alloc();
+    }
+    return memory;
+}
+
+void operator delete(void* memory) noexcept { free(memory); }
+void operator delete(void* memory, size_t) noexcept { free(memory); }
+
+// Sums the edge weights along a dense path, -1 if a hop is not an edge
+template <typename T>
+double pathWeight(const CSRGraph<T>& csr, const vector<int>& path) {
+    double sum = 0;
+    for (size_t i = 0; i + 1 < path.size(); i++) {
+        double hop = -1;
+        for (int e = csr.edgeBegin(path[i]); e < csr.edgeEnd(path[i]); e++) {
+            if (csr.target(e) == path[i + 1]) {
+                hop = csr.weight(e);
+            }
+        }
+        if (hop < 0) {
+            return -1;
+        }
+        sum += hop;
+    }
+    return sum;
+}
+
+// Builds a rows x cols road grid around Granville with OSM-style IDs.
+// Every street runs both ways and each direction gets a weight between
+// one and two times the length of the block, like a slow street.
+WeightedGraph<long long> makeGridGraph(int rows, int cols, unsigned seed) {
+    WeightedGraph<long long> graph;
+    srand(seed);
+    const long long firstId = 7234391442LL;
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) {
+            graph.addVertex(firstId + r * cols + c, -82.52 + 0.001 * c, 40.07 + 0.001 * r);
+        }
+    }
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) {
+            long long id = firstId + r * cols + c;
+            if (c + 1 < cols) {
+                graph.addEdge(id, id + 1, 85.2 * (1 + rand() % 100 / 100.0));
+                graph.addEdge(id + 1, id, 85.2 * (1 + rand() % 100 / 100.0));
+            }
+            if (r + 1 < rows) {
+                graph.addEdge(id, id + cols, 111.2 * (1 + rand() % 100 / 100.0));
+                graph.addEdge(id + cols, id, 111.2 * (1 + rand() % 100 / 100.0));
+            }
+        }
+    }
+    graph.freeze();
+    return graph;
+}
+
+// Copies a graph with its node IDs shuffled, so IDs say nothing
+// about where nodes are, as with raw map data
+WeightedGraph<long long> scrambleIds(WeightedGraph<long long>& graph, unsigned seed) {
+    const CSRGraph<long long>& csr = graph.freeze();
+    vector<long long> newIds(csr.numNodes());
+    for (int u = 0; u < csr.numNodes(); u++) {
+        newIds[u] = csr.nodeId(u);
+    }
+    mt19937 shuffler(seed);
+    shuffle(newIds.begin(), newIds.end(), shuffler);
+
+    WeightedGraph<long long> scrambled;
+    for (int u = 0; u < csr.numNodes(); u++) {
+        scrambled.addVertex(newIds[u], csr.coord(u).first, csr.coord(u).second);
+        for (int e = csr.edgeBegin(u); e < csr.edgeEnd(u); e++) {
+            scrambled.addEdge(newIds[u], newIds[csr.target(e)], csr.weight(e));
+        }
+    }
+    scrambled.freeze();
+    return scrambled;
+}
+
+// Builds a random graph of n nodes where every node has degree
+// out-edges to other random nodes, for decreaseKey-heavy searches
+WeightedGraph<long long> makeDenseGraph(int n, int degree, unsigned seed) {
+    WeightedGraph<long long> graph;
+    srand(seed);
+    for (int i = 0; i < n; i++) {
+        graph.addVertex(i, -82.52 + 0.001 * (rand() % 1000), 40.07 + 0.001 * (rand() % 1000));
+    }
+    for (int i = 0; i < n; i++) {
+        for (int d = 0; d < degree; d++) {
+            int j = rand() % (n - 1);
+            graph.addEdge(i, j < i ? j : j + 1, 1 + rand() % 1000);
+        }
+    }
+    graph.freeze();
+    return graph;
+}
+
+// Picks query coordinates from vertices of the graph
+vector<pair<double, double> > randomCoords(const CSRGraph<long long>& csr, int count, unsigned seed) {
+    vector<pair<double, double> > picks;
+    srand(seed);
+    while (static_cast<int>(picks.size()) < count) {
+        pair<double, double> c = csr.coord(rand() % csr.numNodes());
+        if (!isnan(c.first)) {
+            picks.push_back(c);
+        }
+    }
+    return picks;
+}
+
 void testPQInsert() {
     PriorityQueue<long> pq;
     pq.insert(1, 10.3);
@@ -69,6 +205,234 @@ void testPQExtractMin() {
     assertTest(min.first == 2 && min.second == 1.4);
 }
 
+void testPQAssign() {
+    PriorityQueue<long> pq({{1, 10.3}, {2, 1.4}, {3, 13.2}, {4, 3.6}, {5, 6.57}});
+    pq.decreaseKey(3, 2.2);
+    assertTest(pq.size() == 5 && pq.extractMin() == make_pair(2L, 1.4) && pq.extractMin() == make_pair(3L, 2.2));
+
+    // a bulk-built heap pops the same priorities as one filled by
+    // insert, for every arity
+    vector<pair<int, double> > items;
+    srand(271);
+    for (int i = 0; i < 1000; i++) {
+        items.push_back(make_pair(i, rand() % 300));
+    }
+    PriorityQueue<int> inserted;
+    for (const pair<int, double>& item : items) {
+        inserted.insert(item.first, item.second);
+    }
+    PriorityQueue<int> built(items);
+    PriorityQueue<int, 4> built4(items);
+    PriorityQueue<int, 8> built8;
+    built8.insert(5000, 0);
+    built8.assign(items);
+    bool samePriorities = built8.size() == 1000 && !built8.contains(5000);
+    while (!inserted.isEmpty()) {
+        double expected = inserted.extractMin().second;
+        samePriorities = samePriorities && built.extractMin().second == expected
+                         && built4.extractMin().second == expected && built8.extractMin().second == expected;
+    }
+    assertTest(samePriorities && built.isEmpty());
+
+    // a repeated node is rejected and the queue is left as it was
+    bool rejected = false;
+    try {
+        pq.assign({{7, 1.0}, {8, 2.0}, {7, 3.0}});
+    } catch (const runtime_error&) {
+        rejected = true;
+    }
+    assertTest(rejected && pq.size() == 3 && pq.peekMin() == make_pair(4L, 3.6));
+}
+
+void testIndexedPQ() {
+    IndexedPriorityQueue<> pq(6);
+    pq.insert(1, 10.3);
+    pq.insert(2, 1.4);
+    pq.insert(3, 13.2);
+    pq.insert(4, 3.6);
+    pq.insert(5, 6.57);
+    pq.decreaseKey(3, 2.2);
+    assertTest(pq.extractMin() == make_pair(2, 1.4) && pq.extractMin() == make_pair(3, 2.2));
+    assertTest(!pq.contains(3) && pq.contains(5) && pq.size() == 3);
+
+    // clearing forgets queued handles so they can be inserted again,
+    // and handles past the current size grow the queue
+    pq.clear();
+    pq.insert(5, 1.0);
+    pq.insert(9, 0.5);
+    assertTest(pq.capacity() == 10 && pq.extractMin().first == 9 && pq.extractMin().first == 5 && pq.isEmpty());
+
+    // pops come out in the same order as PriorityQueue, ties included
+    PriorityQueue<int> reference;
+    IndexedPriorityQueue<> indexed(500);
+    srand(271);
+    bool sameOrder = true;
+    for (int i = 0; i < 500; i++) {
+        double priority = rand() % 50;
+        reference.insert(i, priority);
+        indexed.insert(i, priority);
+        if (i % 3 == 0) {
+            int handle = rand() % (i + 1);
+            if (indexed.contains(handle)) {
+                reference.decreaseKey(handle, priority / 2);
+                indexed.decreaseKey(handle, priority / 2);
+            }
+        }
+        if (i % 4 == 0) {
+            sameOrder = sameOrder && reference.extractMin() == indexed.extractMin();
+        }
+    }
+    while (!reference.isEmpty()) {
+        sameOrder = sameOrder && reference.extractMin() == indexed.extractMin();
+    }
+    assertTest(sameOrder && indexed.isEmpty());
+}
+
+void testPairingHeap() {
+    PairingHeap<long> pq;
+    pq.insert(1, 10.3);
+    pq.insert(2, 1.4);
+    pq.insert(3, 13.2);
+    pq.insert(4, 3.6);
+    pq.insert(5, 6.57);
+    pq.decreaseKey(3, 2.2);
+    pq.decreaseKey(4, 9.0);
+    assertTest(pq.extractMin() == make_pair(2L, 1.4) && pq.extractMin() == make_pair(3L, 2.2));
+    assertTest(!pq.contains(3) && pq.contains(4) && pq.size() == 3 && pq.peekMin() == make_pair(4L, 3.6));
+
+    // pops the same priorities as PriorityQueue on a random mix
+    // (ties may come out in a different order)
+    PriorityQueue<int> reference;
+    PairingHeap<int> pairing;
+    srand(271);
+    bool samePriorities = true;
+    for (int i = 0; i < 2000; i++) {
+        double priority = rand() % 500;
+        reference.insert(i, priority);
+        pairing.insert(i, priority);
+        int handle = rand() % (i + 1);
+        if (pairing.contains(handle)) {
+            reference.decreaseKey(handle, priority / 3);
+            pairing.decreaseKey(handle, priority / 3);
+        }
+        if (i % 3 == 0) {
+            samePriorities = samePriorities && reference.extractMin().second == pairing.extractMin().second;
+        }
+    }
+    while (!reference.isEmpty()) {
+        samePriorities = samePriorities && reference.extractMin().second == pairing.extractMin().second;
+    }
+    assertTest(samePriorities && pairing.isEmpty());
+
+    bool rejected = false;
+    try {
+        pairing.insert(7, 1.0);
+        pairing.insert(7, 2.0);
+    } catch (const runtime_error&) {
+        rejected = true;
+    }
+    pairing.clear();
+    assertTest(rejected && pairing.isEmpty() && !pairing.contains(7));
+
+    // once warmed up and cleared, the same mix of inserts, decreases
+    // and extractions allocates nothing, with IDs far apart as in
+    // real maps
+    PairingHeap<long long> pooled;
+    auto cycle = [&]() {
+        srand(271);
+        bool sorted = true;
+        for (long long i = 0; i < 2000; i++) {
+            pooled.insert(i * 7919 + 6000000000LL, rand() % 500);
+            long long handle = (rand() % (i + 1)) * 7919 + 6000000000LL;
+            if (pooled.contains(handle)) {
+                pooled.decreaseKey(handle, rand() % 100);
+            }
+            if (i % 3 == 0) {
+                pooled.extractMin();
+            }
+        }
+        double last = -1;
+        while (!pooled.isEmpty()) {
+            double priority = pooled.extractMin().second;
+            sorted = sorted && priority >= last;
+            last = priority;
+        }
+        return sorted;
+    };
+    cycle();
+    pooled.clear();
+    long long before = allocations;
+    bool sorted = cycle();
+    assertTest(allocations == before && sorted && pooled.size() == 0);
+}
+
+// Pushes random priorities through a monotone queue the way
+// Dijkstra would (never below the last extracted one) and checks
+// they come out sorted
+template <typename Q>
+bool extractsInOrder(Q& queue) {
+    srand(271);
+    double last = 0;
+    bool sorted = true;
+    for (int i = 0; i < 2000; i++) {
+        queue.insert(i, last + rand() % 1000 / 7.0);
+        int handle = rand() % (i + 1);
+        if (queue.contains(handle)) {
+            queue.decreaseKey(handle, last + rand() % 100 / 7.0);
+        }
+        if (i % 2 == 0) {
+            double next = queue.extractMin().second;
+            sorted = sorted && next >= last;
+            last = next;
+        }
+    }
+    while (!queue.isEmpty()) {
+        double next = queue.extractMin().second;
+        sorted = sorted && next >= last;
+        last = next;
+    }
+    return sorted;
+}
+
+void testMonotoneQueues() {
+    RadixHeap radix;
+    DialQueue dial(2.5);
+    assertTest(extractsInOrder(radix) && extractsInOrder(dial));
+
+    // neither queue can go back below the last extracted priority
+    bool rejected = false;
+    try {
+        radix.insert(0, 10);
+        radix.extractMin();
+        radix.insert(1, 9);
+    } catch (const invalid_argument&) {
+        rejected = true;
+    }
+    assertTest(rejected);
+
+    // every queue type finds the same distances
+    WeightedGraph<long long> graphs[2] = {
+        WeightedGraph<long long>::readFromFile("denison.out"),
+        makeGridGraph(20, 20, 271)
+    };
+    bool allMatch = true;
+    for (WeightedGraph<long long>& g : graphs) {
+        const CSRGraph<long long>& csr = g.freeze();
+        SearchWorkspace binary, radixWs, dialWs;
+        radixWs.queueType = RADIX_HEAP;
+        dialWs.queueType = DIAL_BUCKETS;
+        srand(271);
+        for (int i = 0; i < 300; i++) {
+            int s = rand() % csr.numNodes();
+            int t = rand() % csr.numNodes();
+            double expected = csr.dijkstras(s, t, binary);
+            allMatch = allMatch && csr.dijkstras(s, t, radixWs) == expected && csr.dijkstras(s, t, dialWs) == expected;
+            allMatch = allMatch && fabs(pathWeight(csr, radixWs.path(t)) - pathWeight(csr, binary.path(t))) < 1e-6;
+        }
+    }
+    assertTest(allMatch);
+}
+
 void testFindNode() {
     WeightedGraph<long> graph = WeightedGraph<long>::readFromFile("testData.txt");
     pair<double, double> nodes = graph.findNode(make_pair(20.45, -18.67), make_pair(40.91, -80.66));
@@ -111,6 +475,49 @@ void testWGEdgeIn() {
 
 void testWGfindNodes() {
     WeightedGraph<int> graph;
+    graph = graph.readFromFile("testData.txt");
+    assertTest(graph.idFromCoords(make_pair(37.19, -18.23)) == 3);
+    assertTest(graph.idFromCoords(make_pair(37.19, -18.24)) == -1);
+    pair<double, double> nodes = graph.findNode(make_pair(20.45, -18.67), make_pair(40.91, -80.66));
+    assertTest(nodes.first == 1 && nodes.second == 5);
+}
+
+void testWGNearestNode() {
+    WeightedGraph<int> graph;
+    graph = graph.readFromFile("testData.txt");
+    pair<double, double> closest = graph.nearestNode(make_pair(40.0, -79.0));
+    assertTest(closest.first == 40.82 && closest.second == -80.47);
+    closest = graph.nearestNode(make_pair(0, 0));
+    assertTest(closest.first == 20.45 && closest.second == -18.67);
+}
+
+void testKDTree() {
+    // every vertex of the campus map must be found again, and the
+    // nearest-node query must agree with a linear scan
+    WeightedGraph<long long> graph = WeightedGraph<long long>::readFromFile("denison.out");
+    const CSRGraph<long long>& csr = graph.freeze();
+    bool allFound = true;
+    bool allNearest = true;
+    for (int u = 0; u < csr.numNodes(); u++) {
+        pair<double, double> c = csr.coord(u);
+        if (isnan(c.first)) {
+            continue;
+        }
+        int found = csr.locate(c);
+        allFound = allFound && found != -1 && csr.coord(found) == c;
+
+        pair<double, double> q = make_pair(c.first + 0.0003, c.second - 0.0002);
+        double best = numeric_limits<double>::infinity();
+        for (int v = 0; v < csr.numNodes(); v++) {
+            pair<double, double> p = csr.coord(v);
+            double d = (p.first - q.first) * (p.first - q.first) + (p.second - q.second) * (p.second - q.second);
+            best = min(best, d);
+        }
+        pair<double, double> p = csr.coord(csr.nearest(q));
+        allNearest = allNearest && (p.first - q.first) * (p.first - q.first) + (p.second - q.second) * (p.second - q.second) == best;
+    }
+    assertTest(allFound);
+    assertTest(allNearest);
 }
 
 void testWGDijkstras() {
@@ -124,17 +531,996 @@ void testWGDijkstras() {
     assertTest(sPath[1].first == 37.19 && sPath[1].second == -18.23);
 }
 
+void testCSRFreeze() {
+    WeightedGraph<long> graph = WeightedGraph<long>::readFromFile("testData.txt");
+    const CSRGraph<long>& csr = graph.freeze();
+    assertTest(csr.numNodes() == 5 && csr.numEdges() == 8);
+    int two = csr.denseId(2);
+    assertTest(csr.nodeId(two) == 2 && csr.denseId(42) == -1);
+    // out-edges of node 2 are 2->3, 2->4, 2->5 sorted by target
+    assertTest(csr.edgeEnd(two) - csr.edgeBegin(two) == 3);
+    assertTest(csr.nodeId(csr.target(csr.edgeBegin(two))) == 3 && csr.weight(csr.edgeBegin(two)) == 15.8);
+    graph.addEdge(1, 5, 42);
+    assertTest(graph.freeze().numEdges() == 9);
+
+    // moving a frozen graph hands its arrays over without copying
+    // them; only the empty graph moved into allocates (its two
+    // one-entry offset arrays)
+    CSRGraph<long> copy = graph.freeze();
+    long long before = allocations;
+    CSRGraph<long> moved(move(copy));
+    CSRGraph<long> assigned;
+    assigned = move(moved);
+    assertTest(allocations - before <= 2 && assigned.numEdges() == 9 && assigned.nodeId(assigned.denseId(2)) == 2);
+}
+
+void testCSRDijkstras() {
+    WeightedGraph<long> graph = WeightedGraph<long>::readFromFile("testData.txt");
+    const CSRGraph<long>& csr = graph.freeze();
+    SearchWorkspace ws;
+    double dist = csr.dijkstras(csr.denseId(2), csr.denseId(5), ws);
+    vector<int> path = ws.path(csr.denseId(5));
+    assertTest(path.size() == 3 && csr.nodeId(path[1]) == 3 && dist == 15.8 + 14.8);
+    // nothing leaves node 5 except 5->4, so 1 is unreachable
+    dist = csr.dijkstras(csr.denseId(5), csr.denseId(1), ws);
+    assertTest(dist == numeric_limits<double>::infinity() && ws.path(csr.denseId(1)).empty());
+}
+
+void testCSRDijkstrasStopsEarly() {
+    // 1 -> 4 is the cheapest edge out of 1, so the search settles 1 and 4
+    // and never has to look at 3 or 5
+    WeightedGraph<long> graph = WeightedGraph<long>::readFromFile("testData.txt");
+    const CSRGraph<long>& csr = graph.freeze();
+    SearchWorkspace ws;
+    csr.dijkstras(csr.denseId(1), csr.denseId(4), ws);
+    assertTest(ws.settled == 2 && !ws.reached(csr.denseId(3)));
+    // reusing the workspace forgets the previous query
+    csr.dijkstras(csr.denseId(3), csr.denseId(5), ws);
+    assertTest(!ws.reached(csr.denseId(1)) && ws.distance(csr.denseId(5)) == 14.8);
+}
+
+void testCSRReverseEdges() {
+    WeightedGraph<long> graph = WeightedGraph<long>::readFromFile("testData.txt");
+    const CSRGraph<long>& csr = graph.freeze();
+    // 4 is entered from 1 (3.1), 2 (144.6) and 5 (16.7)
+    int four = csr.denseId(4);
+    assertTest(csr.reverseEdgeEnd(four) - csr.reverseEdgeBegin(four) == 3);
+    int e = csr.reverseEdgeBegin(four);
+    assertTest(csr.nodeId(csr.reverseSource(e)) == 1 && csr.reverseWeight(e) == 3.1);
+    assertTest(csr.nodeId(csr.reverseSource(e + 2)) == 5 && csr.reverseWeight(e + 2) == 16.7);
+}
+
+void testWorkspaceReuse() {
+    WeightedGraph<long long> graph = WeightedGraph<long long>::readFromFile("denison.out");
+    vector<pair<double, double> > picks = randomCoords(graph.freeze(), 200, 271);
+    SearchWorkspace ws;
+    vector<pair<double, double> > route;
+
+    // same routes as the allocating version
+    bool sameRoutes = true;
+    for (int i = 0; i < 100; i++) {
+        double weight = graph.dijkstras(picks[2 * i], picks[2 * i + 1], ws, route);
+        vector<int> densePath = ws.path(graph.freeze().locate(picks[2 * i + 1]));
+        double expected = densePath.empty() ? numeric_limits<double>::infinity() : pathWeight(graph.freeze(), densePath);
+        sameRoutes = sameRoutes && route == graph.dijkstras(picks[2 * i], picks[2 * i + 1])
+                     && (weight == expected || fabs(weight - expected) < 1e-6);
+    }
+    assertTest(sameRoutes);
+
+    // once the workspace and route have grown, the same queries
+    // again allocate nothing
+    long long before = allocations;
+    for (int i = 0; i < 100; i++) {
+        graph.dijkstras(picks[2 * i], picks[2 * i + 1], ws, route);
+    }
+    assertTest(allocations == before);
+
+    // a fresh workspace only allocates the queue it uses: dist,
+    // parent, stamp and the binary heap's positions
+    SearchWorkspace fresh;
+    before = allocations;
+    fresh.reset(graph.freeze().numNodes());
+    assertTest(allocations - before == 4);
+
+    // switching queues sizes the new one and still finds the same routes
+    bool sameSwitched = true;
+    for (int i = 0; i < 30; i++) {
+        fresh.queueType = static_cast<QueueType>(i % 3);
+        sameSwitched = sameSwitched && graph.dijkstras(picks[2 * i], picks[2 * i + 1], fresh, route)
+                                       == graph.dijkstras(picks[2 * i], picks[2 * i + 1], ws, route);
+    }
+    assertTest(sameSwitched);
+
+    // one workspace per thread on a shared frozen graph
+    vector<double> weights(100);
+    runParallel(4, [&](int t) {
+        SearchWorkspace threadWs;
+        vector<pair<double, double> > threadRoute;
+        for (int i = t; i < 100; i += 4) {
+            weights[i] = graph.dijkstras(picks[2 * i], picks[2 * i + 1], threadWs, threadRoute);
+        }
+    });
+    bool sameWeights = true;
+    for (int i = 0; i < 100; i++) {
+        sameWeights = sameWeights && weights[i] == graph.dijkstras(picks[2 * i], picks[2 * i + 1], ws, route);
+    }
+    assertTest(sameWeights);
+}
+
+void testShortestRoute() {
+    WeightedGraph<long long> graph = WeightedGraph<long long>::readFromFile("denison.out");
+    vector<pair<double, double> > picks = randomCoords(graph.freeze(), 40, 271);
+    const unordered_map<long long, unordered_map<long long, double> >& adjacency = graph.getAdjacencyList();
+
+    // IDs, coordinates and weight all describe the same path
+    bool consistent = true;
+    for (int i = 0; i < 20; i++) {
+        Route<long long> route = graph.shortestRoute(picks[2 * i], picks[2 * i + 1]);
+        if (route.ids.empty()) {
+            continue;
+        }
+        double weight = 0;
+        for (size_t j = 0; j < route.ids.size(); j++) {
+            consistent = consistent && graph.getCoords().at(route.ids[j]) == route.coords[j];
+            if (j + 1 < route.ids.size()) {
+                weight += adjacency.at(route.ids[j]).at(route.ids[j + 1]);
+            }
+        }
+        consistent = consistent && route.coords == graph.dijkstras(picks[2 * i], picks[2 * i + 1])
+                     && fabs(weight - route.weight) < 1e-6;
+    }
+    assertTest(consistent);
+
+    // no path leaves the lists empty
+    WeightedGraph<long long> island;
+    island.addVertex(1, 0, 0);
+    island.addVertex(2, 1, 0);
+    island.addVertex(3, 2, 0);
+    island.addEdge(1, 2, 4.5);
+    Route<long long> route = island.shortestRoute(make_pair(0.0, 0.0), make_pair(1.0, 0.0));
+    assertTest(route.ids == vector<long long>({1, 2}) && route.weight == 4.5);
+    route = island.shortestRoute(make_pair(0.0, 0.0), make_pair(2.0, 0.0));
+    assertTest(route.ids.empty() && route.coords.empty() && isinf(route.weight));
+}
+
+// Builds the answer RouteServer should give for one query
+string expectedAnswer(WeightedGraph<long long>& graph, pair<double, double> start, pair<double, double> end) {
+    Route<long long> route = graph.shortestRoute(start, end);
+    if (route.ids.empty()) {
+        return "no path";
+    }
+    char number[32];
+    string answer(number, to_chars(number, number + sizeof(number), route.weight).ptr);
+    for (long long id : route.ids) {
+        answer += " " + to_string(id);
+    }
+    return answer;
+}
+
+// Connects to a Unix domain socket, retrying while the server starts;
+// -1 if it never answers
+int connectSocket(const string& socketPath) {
+    for (int attempt = 0; attempt < 200; attempt++) {
+        int client = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un address = {};
+        address.sun_family = AF_UNIX;
+        strcpy(address.sun_path, socketPath.c_str());
+        if (connect(client, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0) {
+            return client;
+        }
+        close(client);
+        this_thread::sleep_for(chrono::milliseconds(10));
+    }
+    return -1;
+}
+
+void writeAll(int fd, const string& data) {
+    for (size_t sent = 0; sent < data.size(); ) {
+        ssize_t n = write(fd, data.data() + sent, data.size() - sent);
+        sent += n > 0 ? n : data.size();
+    }
+}
+
+void testRouteServer() {
+    WeightedGraph<long long> graph = WeightedGraph<long long>::readFromFile("denison.out");
+    vector<pair<double, double> > picks = randomCoords(graph.freeze(), 400, 271);
+    RouteServer<long long> server(graph, 4);
+
+    stringstream queries;
+    string expected;
+    queries << setprecision(17);
+    for (int i = 0; i < 200; i++) {
+        queries << picks[2 * i].first << " " << picks[2 * i].second << " "
+                << picks[2 * i + 1].first << " " << picks[2 * i + 1].second << "\n";
+        expected += expectedAnswer(graph, picks[2 * i], picks[2 * i + 1]) + "\n";
+    }
+    // bad lines get an error naming their line; blank lines are skipped
+    queries << "\n1 2 three 4\n0 0 0 0\n";
+    expected += "error: line 202: end x 'three' is not a number\n";
+    expected += "error: line 203: start or end coord not found\n";
+
+    // answers come back in order, whatever thread computed them
+    stringstream answers;
+    long long answered = server.serve(queries, answers);
+    assertTest(answered == 202 && answers.str() == expected);
+
+    // the same queries over a local socket, after a client that
+    // hangs up without reading its answers
+    string socketPath = "/tmp/routeServerTest." + to_string(getpid());
+    thread listener([&]() { server.serveSocket(socketPath, 2); });
+    string request = queries.str();
+    int quitter = connectSocket(socketPath);
+    if (quitter >= 0) {
+        writeAll(quitter, request);
+        close(quitter);
+    }
+    string reply;
+    int client = connectSocket(socketPath);
+    if (client >= 0) {
+        writeAll(client, request);
+        shutdown(client, SHUT_WR);
+        char buffer[4096];
+        ssize_t got;
+        while ((got = read(client, buffer, sizeof(buffer))) > 0) {
+            reply.append(buffer, got);
+        }
+        close(client);
+    }
+    listener.join();
+    assertTest(reply == expected);
+}
+
+void testRouteCache() {
+    // least recently used routes are dropped first
+    RouteCache<long long> cache(2);
+    Route<long long> a, b, c, found;
+    a.ids = {1, 2};
+    b.ids = {2, 3};
+    c.ids = {3, 4};
+    cache.store(1, 2, a);
+    cache.store(2, 3, b);
+    bool hitA = cache.lookup(1, 2, found) && found.ids == a.ids;
+    cache.store(3, 4, c);
+    assertTest(hitA && !cache.lookup(2, 3, found) && cache.lookup(1, 2, found) && cache.lookup(3, 4, found)
+               && cache.size() == 2 && cache.hits() == 3 && cache.misses() == 1);
+
+    // repeated queries are answered from the cache with the same route
+    WeightedGraph<long long> graph = WeightedGraph<long long>::readFromFile("denison.out");
+    vector<pair<double, double> > picks = randomCoords(graph.freeze(), 40, 271);
+    graph.setRouteCacheSize(100);
+    bool sameRoutes = true;
+    for (int i = 0; i < 20; i++) {
+        Route<long long> first = graph.shortestRoute(picks[2 * i], picks[2 * i + 1]);
+        vector<pair<double, double> > second = graph.dijkstras(picks[2 * i], picks[2 * i + 1]);
+        sameRoutes = sameRoutes && (first.coords.empty() ? second.size() == 1 : first.coords == second);
+    }
+    assertTest(sameRoutes && graph.getRouteCache().misses() == 20 && graph.getRouteCache().hits() == 20);
+
+    // editing the graph drops every cached route
+    Route<long long> before = graph.shortestRoute(picks[0], picks[1]);
+    graph.addEdge(graph.idFromCoords(picks[0]), graph.idFromCoords(picks[1]), 0.5);
+    assertTest(graph.getRouteCache().size() == 0);
+    Route<long long> after = graph.shortestRoute(picks[0], picks[1]);
+    assertTest(after.weight == 0.5 && after.weight < before.weight && after.ids.size() == 2);
+
+    // threads with their own workspaces share the cache safely
+    const CSRGraph<long long>& csr = graph.freeze();
+    long long lookups = graph.getRouteCache().hits() + graph.getRouteCache().misses();
+    vector<double> weights(200);
+    runParallel(4, [&](int t) {
+        SearchWorkspace ws;
+        Route<long long> route;
+        for (int i = t; i < 200; i += 4) {
+            weights[i] = graph.dijkstras(picks[2 * (i % 20)], picks[2 * (i % 20) + 1], ws, route);
+        }
+    });
+    SearchWorkspace ws;
+    bool sameWeights = true;
+    for (int i = 0; i < 200; i++) {
+        sameWeights = sameWeights && weights[i] == csr.dijkstras(csr.locate(picks[2 * (i % 20)]), csr.locate(picks[2 * (i % 20) + 1]), ws);
+    }
+    assertTest(sameWeights && graph.getRouteCache().hits() + graph.getRouteCache().misses() == lookups + 200);
+}
+
+void testBidirectionalDijkstras() {
+    WeightedGraph<int> graph;
+    graph = graph.readFromFile("testData.txt");
+    vector<pair<double, double>> sPath = graph.bidirectionalDijkstras(make_pair(25.37, -15.24), make_pair(40.91, -80.66));
+    assertTest(sPath.size() == 3 && sPath[1].first == 37.19 && sPath[1].second == -18.23);
+
+    // on the campus map both searches must agree on every distance and
+    // the bidirectional path must add up to that distance
+    WeightedGraph<long long> campus = WeightedGraph<long long>::readFromFile("denison.out");
+    const CSRGraph<long long>& csr = campus.freeze();
+    SearchWorkspace ws, forward, backward;
+    bool allMatch = true;
+    srand(271);
+    for (int i = 0; i < 500; i++) {
+        int s = rand() % csr.numNodes();
+        int t = rand() % csr.numNodes();
+        double expected = csr.dijkstras(s, t, ws);
+        double actual = csr.bidirectionalDijkstras(s, t, forward, backward);
+        vector<int> path = forward.path(t);
+        double sum = pathWeight(csr, path);
+        bool found = expected != numeric_limits<double>::infinity();
+        allMatch = allMatch && (expected == actual || fabs(expected - actual) < 1e-6);
+        allMatch = allMatch && (!found || (path.front() == s && path.back() == t && fabs(sum - actual) < 1e-6));
+    }
+    assertTest(allMatch);
+}
+
+void testAStar() {
+    WeightedGraph<int> graph;
+    graph = graph.readFromFile("testData.txt");
+    vector<pair<double, double>> sPath = graph.aStar(make_pair(25.37, -15.24), make_pair(40.91, -80.66));
+    assertTest(sPath.size() == 3 && sPath[1].first == 37.19 && sPath[1].second == -18.23);
+
+    // campus edges are at least as long as the great-circle distance
+    // between their ends, so the bound must be usable there
+    WeightedGraph<long long> campus = WeightedGraph<long long>::readFromFile("denison.out");
+    const CSRGraph<long long>& csr = campus.freeze();
+    assertTest(csr.heuristicScale() > 0);
+
+    SearchWorkspace ws, aws;
+    bool allMatch = true;
+    long dijkstraSettled = 0, aStarSettled = 0;
+    srand(271);
+    for (int i = 0; i < 500; i++) {
+        int s = rand() % csr.numNodes();
+        int t = rand() % csr.numNodes();
+        double expected = csr.dijkstras(s, t, ws);
+        double actual = csr.aStar(s, t, aws);
+        allMatch = allMatch && (expected == actual || fabs(expected - actual) < 1e-6);
+        if (expected != numeric_limits<double>::infinity()) {
+            dijkstraSettled += ws.settled;
+            aStarSettled += aws.settled;
+        }
+    }
+    assertTest(allMatch);
+    assertTest(aStarSettled < dijkstraSettled);
+
+    // a node without coordinates makes the bound unprovable
+    graph.addEdge(5, 99, 1.0);
+    assertTest(graph.freeze().heuristicScale() == 0);
+}
+
+void testContractionHierarchy() {
+    WeightedGraph<int> graph;
+    graph = graph.readFromFile("testData.txt");
+    vector<pair<double, double>> sPath = graph.contractionHierarchyQuery(make_pair(25.37, -15.24), make_pair(40.91, -80.66));
+    assertTest(sPath.size() == 3 && sPath[1].first == 37.19 && sPath[1].second == -18.23);
+
+    // distances must match Dijkstra's and unpacked shortcuts must be
+    // a real path of original edges with the same weight
+    WeightedGraph<long long> graphs[2] = {
+        WeightedGraph<long long>::readFromFile("denison.out"),
+        makeGridGraph(20, 20, 271)
+    };
+    for (WeightedGraph<long long>& g : graphs) {
+        const CSRGraph<long long>& csr = g.freeze();
+        const ContractionHierarchy<long long>& ch = g.contract();
+        SearchWorkspace ws, forward, backward;
+        vector<int> path;
+        bool allMatch = true;
+        srand(271);
+        for (int i = 0; i < 500; i++) {
+            int s = rand() % csr.numNodes();
+            int t = rand() % csr.numNodes();
+            double expected = csr.dijkstras(s, t, ws);
+            double actual = ch.query(s, t, forward, backward, path);
+            allMatch = allMatch && (expected == actual || fabs(expected - actual) < 1e-6);
+            if (expected != numeric_limits<double>::infinity()) {
+                allMatch = allMatch && path.front() == s && path.back() == t;
+                allMatch = allMatch && fabs(pathWeight(csr, path) - actual) < 1e-6;
+            }
+        }
+        assertTest(allMatch);
+    }
+}
+
+// Writes text to a scratch file and tries to read it as a graph,
+// returning the line of the parse error or 0 if it parsed. threads
+// above 0 uses the parallel loader.
+int parseErrorLine(const string& text, int threads = 0) {
+    ofstream("parser.tmp") << text;
+    try {
+        if (threads > 0) {
+            WeightedGraph<int>::readFromFileParallel("parser.tmp", threads);
+        } else {
+            WeightedGraph<int>::readFromFile("parser.tmp");
+        }
+    } catch (const parse_exception& e) {
+        return e.line;
+    }
+    return 0;
+}
+
+// True if two CSR graphs hold exactly the same nodes and edges
+template <typename T>
+bool sameGraph(const CSRGraph<T>& a, const CSRGraph<T>& b) {
+    if (a.numNodes() != b.numNodes() || a.numEdges() != b.numEdges() || a.heuristicScale() != b.heuristicScale()) {
+        return false;
+    }
+    for (int u = 0; u < a.numNodes(); u++) {
+        pair<double, double> ca = a.coord(u), cb = b.coord(u);
+        bool sameCoord = ca == cb || (isnan(ca.first) && isnan(cb.first));
+        if (a.nodeId(u) != b.nodeId(u) || !sameCoord || a.edgeEnd(u) != b.edgeEnd(u) || a.reverseEdgeEnd(u) != b.reverseEdgeEnd(u)) {
+            return false;
+        }
+    }
+    for (int e = 0; e < a.numEdges(); e++) {
+        if (a.target(e) != b.target(e) || a.weight(e) != b.weight(e) ||
+            a.reverseSource(e) != b.reverseSource(e) || a.reverseWeight(e) != b.reverseWeight(e)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void testOneToAll() {
+    WeightedGraph<long long> graph = WeightedGraph<long long>::readFromFile("denison.out");
+    const CSRGraph<long long>& csr = graph.freeze();
+    pair<double, double> start = randomCoords(csr, 1, 271)[0];
+    int source = csr.locate(start);
+    vector<double> distances;
+    vector<int> parents;
+
+    // with no cutoff every distance matches a point query and
+    // parents form a tree of shortest paths
+    int reached = graph.oneToAll(start, distances, parents);
+    SearchWorkspace ws;
+    bool sameDistances = static_cast<int>(distances.size()) == csr.numNodes() && parents[source] == -1;
+    int finite = 0;
+    for (int u = 0; u < csr.numNodes(); u++) {
+        finite += !isinf(distances[u]);
+        sameDistances = sameDistances && distances[u] == csr.dijkstras(source, u, ws);
+        if (parents[u] != -1) {
+            sameDistances = sameDistances && fabs(distances[parents[u]] + pathWeight(csr, {parents[u], u}) - distances[u]) < 1e-6;
+        }
+    }
+    assertTest(sameDistances && reached == finite);
+
+    // a cutoff keeps exactly the nodes within it
+    vector<double> all = distances;
+    double cutoff = 500;
+    int within = graph.oneToAll(start, distances, parents, cutoff);
+    bool cutOff = within > 1 && within < reached;
+    int expected = 0;
+    for (int u = 0; u < csr.numNodes(); u++) {
+        expected += all[u] <= cutoff;
+        cutOff = cutOff && (all[u] <= cutoff ? distances[u] == all[u] : isinf(distances[u]) && parents[u] == -1);
+    }
+    assertTest(cutOff && within == expected);
+
+    // isochrone bands split the same nodes by distance
+    vector<double> bands = {100, 250, 500};
+    vector<vector<pair<double, double> > > groups = graph.isochrones(start, bands);
+    bool banded = groups.size() == 3 && groups[0].size() + groups[1].size() + groups[2].size() == static_cast<size_t>(within);
+    for (size_t b = 0; b < groups.size(); b++) {
+        for (pair<double, double> c : groups[b]) {
+            double d = all[csr.locate(c)];
+            banded = banded && d <= bands[b] && (b == 0 || d > bands[b - 1]);
+        }
+    }
+    bool rejected = false;
+    try {
+        graph.isochrones(start, {250, 100});
+    } catch (const invalid_argument&) {
+        rejected = true;
+    }
+    assertTest(banded && rejected);
+}
+
+void testDistanceMatrix() {
+    WeightedGraph<long long> campus = WeightedGraph<long long>::readFromFile("denison.out");
+    const CSRGraph<long long>& csr = campus.freeze();
+    vector<pair<double, double> > picks = randomCoords(csr, 40, 271);
+    vector<pair<double, double> > sources(picks.begin(), picks.begin() + 15);
+    vector<pair<double, double> > destinations(picks.begin() + 15, picks.end());
+    sources.push_back(sources[3]);  // repeated start
+    destinations.push_back(sources[0]);  // start and end on the same node
+
+    SearchWorkspace ws;
+    bool allMatch = true;
+    for (int threads : {1, 4}) {
+        vector<vector<double> > matrix = campus.distanceMatrix(sources, destinations, threads);
+        allMatch = allMatch && matrix.size() == sources.size();
+        for (size_t i = 0; i < sources.size(); i++) {
+            for (size_t j = 0; j < destinations.size(); j++) {
+                double expected = csr.dijkstras(csr.locate(sources[i]), csr.locate(destinations[j]), ws);
+                allMatch = allMatch && matrix[i][j] == expected;
+            }
+        }
+    }
+    assertTest(allMatch);
+
+    bool rejected = false;
+    try {
+        campus.distanceMatrix(sources, {make_pair(0.0, 0.0)});
+    } catch (const invalid_argument&) {
+        rejected = true;
+    }
+    assertTest(rejected);
+}
+
+void testDynamicShortestPaths() {
+    // random weight rises and falls on a grid, checked after every
+    // change against a graph rebuilt with the same weights
+    WeightedGraph<long long> graph = makeGridGraph(20, 20, 271);
+    const CSRGraph<long long>& initial = graph.freeze();
+    DynamicShortestPaths<long long> dynamic(initial);
+    vector<long long> pinned = {initial.nodeId(0), initial.nodeId(210), initial.nodeId(399)};
+    for (long long source : pinned) {
+        dynamic.pin(source);
+    }
+    vector<pair<long long, long long> > edges;
+    for (int u = 0; u < initial.numNodes(); u++) {
+        for (int e = initial.edgeBegin(u); e < initial.edgeEnd(u); e++) {
+            edges.push_back(make_pair(initial.nodeId(u), initial.nodeId(initial.target(e))));
+        }
+    }
+
+    srand(271);
+    bool sameDistances = dynamic.pinnedCount() == 3;
+    bool validPaths = true;
+    SearchWorkspace ws;
+    vector<double> distances;
+    vector<int> parents;
+    for (int update = 0; update < 60; update++) {
+        pair<long long, long long> edge = edges[rand() % edges.size()];
+        double weight = update % 3 == 0 ? 1000 + rand() % 1000 : rand() % 100;
+        if (update % 10 == 9) {
+            weight = 1e9;   // a closed road
+        }
+        dynamic.setWeight(edge.first, edge.second, weight);
+        graph.addEdge(edge.first, edge.second, weight);
+
+        const CSRGraph<long long>& csr = graph.freeze();
+        for (long long source : pinned) {
+            csr.oneToAll(csr.denseId(source), numeric_limits<double>::infinity(), ws, distances, parents);
+            for (int v = 0; v < csr.numNodes(); v++) {
+                double got = dynamic.distance(source, csr.nodeId(v));
+                sameDistances = sameDistances && fabs(got - distances[v]) <= 1e-9 * max(1.0, distances[v]);
+            }
+            vector<long long> path = dynamic.path(source, csr.nodeId(update % csr.numNodes()));
+            double sum = 0;
+            for (size_t i = 0; i + 1 < path.size(); i++) {
+                sum += dynamic.edgeWeight(path[i], path[i + 1]);
+            }
+            validPaths = validPaths && !path.empty() && path[0] == source
+                         && fabs(sum - dynamic.distance(source, path.back())) <= 1e-9 * max(1.0, sum);
+        }
+    }
+    assertTest(sameDistances);
+    assertTest(validPaths);
+
+    // only existing edges can change
+    bool rejected = false;
+    try {
+        dynamic.setWeight(pinned[0], pinned[2], 1.0);
+    } catch (const invalid_argument&) {
+        rejected = true;
+    }
+    dynamic.unpin(pinned[1]);
+    assertTest(rejected && dynamic.pinnedCount() == 2 && !dynamic.isPinned(pinned[1]));
+}
+
+// Weights of every loopless path from u to target, by depth first search
+void simplePathWeights(const CSRGraph<long long>& csr, int u, int target, double weight, vector<char>& onPath, vector<double>& weights) {
+    if (u == target) {
+        weights.push_back(weight);
+        return;
+    }
+    onPath[u] = 1;
+    for (int e = csr.edgeBegin(u); e < csr.edgeEnd(u); e++) {
+        if (!onPath[csr.target(e)]) {
+            simplePathWeights(csr, csr.target(e), target, weight + csr.weight(e), onPath, weights);
+        }
+    }
+    onPath[u] = 0;
+}
+
+void testKShortestPaths() {
+    // the k lightest loopless paths across a small grid, against
+    // every loopless path listed by brute force
+    WeightedGraph<long long> grid = makeGridGraph(4, 4, 271);
+    const CSRGraph<long long>& small = grid.freeze();
+    vector<double> all;
+    vector<char> onPath(small.numNodes(), 0);
+    simplePathWeights(small, 0, 15, 0, onPath, all);
+    sort(all.begin(), all.end());
+    vector<Route<long long> > routes = grid.kShortestPaths(small.coord(0), small.coord(15), 10, 4);
+    bool lightest = routes.size() == 10;
+    for (size_t i = 0; i < routes.size() && i < all.size(); i++) {
+        lightest = lightest && fabs(routes[i].weight - all[i]) < 1e-6;
+    }
+    assertTest(lightest);
+
+    // on a real map: distinct loopless paths in weight order, the
+    // first one being the shortest, and the same answer on one thread
+    WeightedGraph<long long> campus = WeightedGraph<long long>::readFromFile("denison.out");
+    const CSRGraph<long long>& csr = campus.freeze();
+    vector<pair<double, double> > picks = randomCoords(csr, 20, 271);
+    bool valid = true;
+    for (int i = 0; i < 10; i++) {
+        vector<Route<long long> > parallel = campus.kShortestPaths(picks[2 * i], picks[2 * i + 1], 5, 4);
+        vector<Route<long long> > serial = campus.kShortestPaths(picks[2 * i], picks[2 * i + 1], 5, 1);
+        Route<long long> best = campus.shortestRoute(picks[2 * i], picks[2 * i + 1]);
+        valid = valid && parallel.size() == serial.size() && (parallel.empty() == best.ids.empty());
+        for (size_t r = 0; r < parallel.size(); r++) {
+            vector<int> dense;
+            for (long long id : parallel[r].ids) {
+                dense.push_back(csr.denseId(id));
+            }
+            vector<int> sorted = dense;
+            sort(sorted.begin(), sorted.end());
+            valid = valid && unique(sorted.begin(), sorted.end()) == sorted.end()
+                    && fabs(pathWeight(csr, dense) - parallel[r].weight) < 1e-6
+                    && parallel[r].ids == serial[r].ids
+                    && (r == 0 ? fabs(parallel[r].weight - best.weight) < 1e-6 : parallel[r].weight >= parallel[r - 1].weight)
+                    && (r == 0 || parallel[r].ids != parallel[r - 1].ids);
+        }
+    }
+    assertTest(valid);
+
+    // a finder held across queries keeps its pool of threads, and
+    // k = 1 is the plain shortest route
+    KShortestPaths<long long> pooled(csr, 4);
+    KShortestPaths<long long> single(csr, 1);
+    bool held = true;
+    for (int i = 0; i < 10; i++) {
+        int source = csr.locate(picks[2 * i]);
+        int target = csr.locate(picks[2 * i + 1]);
+        vector<Route<long long> > one = pooled.find(source, target, 1);
+        Route<long long> best = campus.shortestRoute(picks[2 * i], picks[2 * i + 1]);
+        held = held && one.size() == (best.ids.empty() ? 0u : 1u)
+               && (one.empty() || (one[0].ids == best.ids && fabs(one[0].weight - best.weight) < 1e-6));
+        vector<Route<long long> > many = pooled.find(source, target, 8);
+        vector<Route<long long> > alone = single.find(source, target, 8);
+        held = held && many.size() == alone.size();
+        for (size_t r = 0; r < many.size() && r < alone.size(); r++) {
+            held = held && many[r].ids == alone[r].ids;
+        }
+    }
+    assertTest(held);
+
+    // the pool passes a task's exception back to the caller and is
+    // still usable afterwards
+    WorkerPool workers(4);
+    atomic<int> ran(0);
+    bool rethrown = false;
+    try {
+        workers.run([&](int t) {
+            ran++;
+            if (t == 2) {
+                throw runtime_error("spur failed");
+            }
+        });
+    } catch (const runtime_error&) {
+        rethrown = true;
+    }
+    workers.run([&](int) { ran++; });
+    assertTest(rethrown && ran == 8);
+}
+
+void testDeltaStepping() {
+    // same distances as the sequential search for tiny, default and
+    // huge deltas, on one thread and on four
+    bool matches = true;
+    vector<double> expected, distances;
+    vector<int> parents;
+    SearchWorkspace ws;
+    for (int graphIndex = 0; graphIndex < 2; graphIndex++) {
+        WeightedGraph<long long> graph = graphIndex == 0 ? WeightedGraph<long long>::readFromFile("denison.out")
+                                                         : makeGridGraph(60, 60, 271);
+        const CSRGraph<long long>& csr = graph.freeze();
+        for (int source : {0, csr.numNodes() / 2, csr.numNodes() - 1}) {
+            int reached = csr.oneToAll(source, numeric_limits<double>::infinity(), ws, expected, parents);
+            for (int threads : {1, 4}) {
+                DeltaStepping<long long> engine(csr, threads);
+                for (double delta : {0.0, 1.0, 1e9}) {
+                    engine.setDelta(delta);
+                    matches = matches && engine.run(source, distances) == reached && distances == expected;
+                }
+            }
+        }
+    }
+    assertTest(matches);
+
+    WeightedGraph<long long> campus = WeightedGraph<long long>::readFromFile("denison.out");
+    vector<double> wrapped;
+    campus.parallelOneToAll(campus.freeze().coord(0), wrapped, 0, 2);
+    campus.oneToAll(campus.freeze().coord(0), expected, parents);
+    assertTest(wrapped == expected);
+
+    bool badDelta = false;
+    try {
+        DeltaStepping<long long> engine(campus.freeze());
+        engine.setDelta(-1);
+    } catch (const invalid_argument&) {
+        badDelta = true;
+    }
+    assertTest(badDelta);
+}
+
+void testGraphParser() {
+    // street names, CRLF line endings, blank lines and a leading '+'
+    ofstream("parser.tmp") << "3 3\r\n1 -82.5 40.07\r\n2 -82.51 +40.08\r\n\r\n3 1e-3 -4.5\r\n"
+                              "1 2 10.5 West Broadway\r\n2 3 4\n3 1 7.25\tHerrick Hall";
+    WeightedGraph<int> graph = WeightedGraph<int>::readFromFile("parser.tmp");
+    assertTest(graph.getSize() == 3 && graph.freeze().numEdges() == 3);
+    assertTest(graph.getCoords().at(3) == make_pair(0.001, -4.5) && graph.getCoords().at(2).second == 40.08);
+    assertTest(graph.getAdjacencyList().at(1).at(2) == 10.5 && graph.getAdjacencyList().at(3).at(1) == 7.25);
+
+    // malformed input is reported with the line it was found on
+    assertTest(parseErrorLine("2 1\n1 0 0\n2 0 zero\n1 2 3\n") == 3);
+    assertTest(parseErrorLine("2 1\n1 0 0\n2 0 0 7\n1 2 3\n") == 3);
+    assertTest(parseErrorLine("2 2\n1 0 0\n2 0 0\n1 2 3\n") == 5);
+    assertTest(parseErrorLine("1 0\n99999999999 0 0\n") == 2);
+    assertTest(parseErrorLine("2 1\n1 0 0\n2 0 0\n1 2\n") == 4);
+    remove("parser.tmp");
+}
+
+void testParallelLoader() {
+    WeightedGraph<long long> campus = WeightedGraph<long long>::readFromFile("denison.out");
+    bool allSame = true;
+    for (int threads : {1, 2, 3, 8}) {
+        WeightedGraph<long long> parallel = WeightedGraph<long long>::readFromFileParallel("denison.out", threads);
+        allSame = allSame && sameGraph(campus.freeze(), parallel.freeze()) && parallel.getSize() == campus.getSize();
+    }
+    assertTest(allSame);
+
+    // repeated vertices and edges (last one wins), an endpoint with no
+    // vertex line, blank lines and text after the m-th edge
+    string text = "3 6\n1 0 0\n2 1 0\n1 5 5\n\n1 2 4 Main Street\n2 1 3\n1 2 9\n\n"
+                  "2 7 1\n7 1 2\n1 2 6\n3 1 not an edge\n";
+    ofstream("parser.tmp") << text;
+    WeightedGraph<int> sequential = WeightedGraph<int>::readFromFile("parser.tmp");
+    allSame = true;
+    for (int threads : {1, 2, 3, 8}) {
+        WeightedGraph<int> parallel = WeightedGraph<int>::readFromFileParallel("parser.tmp", threads);
+        allSame = allSame && sameGraph(sequential.freeze(), parallel.freeze());
+        allSame = allSame && parallel.getAdjacencyList().at(1).at(2) == 6 && parallel.getCoords().at(1) == make_pair(5.0, 5.0);
+    }
+    assertTest(allSame);
+
+    // errors are reported on the same line as the sequential loader
+    bool sameErrors = true;
+    for (const string& bad : {string("2 3\n1 0 0\n2 0 0\n1 2 3\n2 x 3\n1 2 1\n"),
+                              string("2 3\n1 0 0\n2 0 0\n1 2 3\n2 1 3\n"),
+                              string("1 0\n1 0\n")}) {
+        int line = parseErrorLine(bad);
+        for (int threads : {1, 2, 3, 8}) {
+            sameErrors = sameErrors && line != 0 && parseErrorLine(bad, threads) == line;
+        }
+    }
+    assertTest(sameErrors);
+    remove("parser.tmp");
+}
+
+void testBinaryGraphFile() {
+    WeightedGraph<long long> campus = WeightedGraph<long long>::readFromFile("denison.out");
+    const CSRGraph<long long>& csr = campus.freeze();
+    campus.writeBinary("denison.bin.tmp");
+
+    // readFromFile recognises the binary header and maps the file
+    WeightedGraph<long long> mapped = WeightedGraph<long long>::readFromFile("denison.bin.tmp");
+    const CSRGraph<long long>& mcsr = mapped.freeze();
+    assertTest(mcsr.numNodes() == csr.numNodes() && mcsr.numEdges() == csr.numEdges());
+    assertTest(mapped.getSize() == campus.getSize() && mcsr.heuristicScale() == csr.heuristicScale());
+
+    SearchWorkspace ws, mws;
+    bool allMatch = true;
+    srand(271);
+    for (int i = 0; i < 200; i++) {
+        int s = rand() % csr.numNodes();
+        int t = rand() % csr.numNodes();
+        allMatch = allMatch && csr.dijkstras(s, t, ws) == mcsr.dijkstras(s, t, mws);
+        allMatch = allMatch && csr.nearest(csr.coord(s)) == mcsr.nearest(mcsr.coord(s));
+    }
+    assertTest(allMatch);
+
+    // threads reading the maps of a mapped graph at once all see
+    // them filled in exactly once
+    const WeightedGraph<long long> shared = WeightedGraph<long long>::readFromBinary("denison.bin.tmp");
+    vector<size_t> edgeLists(4), coordCounts(4);
+    runParallel(4, [&](int t) {
+        edgeLists[t] = shared.getAdjacencyList().size();
+        coordCounts[t] = shared.getCoords().size();
+    });
+    bool sameMaps = true;
+    for (int t = 0; t < 4; t++) {
+        sameMaps = sameMaps && edgeLists[t] == campus.getAdjacencyList().size() && coordCounts[t] == campus.getCoords().size();
+    }
+    assertTest(sameMaps);
+
+    // editing a mapped graph rebuilds the maps from the file first
+    assertTest(mapped.getCoords().size() == campus.getCoords().size());
+    mapped.addEdge(csr.nodeId(0), csr.nodeId(1), 1.0);
+    assertTest(mapped.freeze().numEdges() >= csr.numEdges());
+
+    // a flipped byte fails the checksum unless verification is skipped
+    fstream file("denison.bin.tmp", ios::in | ios::out | ios::binary);
+    file.seekp(-1, ios::end);
+    file.put('\x7f');
+    file.close();
+    bool rejected = false;
+    try {
+        WeightedGraph<long long>::readFromBinary("denison.bin.tmp");
+    } catch (const runtime_error&) {
+        rejected = true;
+    }
+    assertTest(rejected);
+    assertTest(WeightedGraph<long long>::readFromBinary("denison.bin.tmp", false).freeze().numNodes() == csr.numNodes());
+
+    // node IDs must be read back with the type they were written with
+    rejected = false;
+    try {
+        WeightedGraph<int>::readFromBinary("denison.bin.tmp", false);
+    } catch (const runtime_error&) {
+        rejected = true;
+    }
+    assertTest(rejected);
+    remove("denison.bin.tmp");
+}
+
+// Mean distance between the dense indices at both ends of an edge
+double meanEdgeSpan(const CSRGraph<long long>& csr) {
+    double total = 0;
+    for (int u = 0; u < csr.numNodes(); u++) {
+        for (int e = csr.edgeBegin(u); e < csr.edgeEnd(u); e++) {
+            total += abs(csr.target(e) - u);
+        }
+    }
+    return total / csr.numEdges();
+}
+
+void testNodeOrder() {
+    WeightedGraph<long long> grid = makeGridGraph(40, 40, 271);
+    WeightedGraph<long long> scrambled = scrambleIds(grid, 271);
+    const CSRGraph<long long> byId = scrambled.freeze();
+    SearchWorkspace ws;
+
+    for (NodeOrder order : {HILBERT_ORDER, RCM_ORDER}) {
+        scrambled.setNodeOrder(order);
+        const CSRGraph<long long>& csr = scrambled.freeze();
+
+        // same nodes, IDs still found, and nodes close together
+        bool lookups = csr.numNodes() == byId.numNodes() && csr.numEdges() == byId.numEdges();
+        for (int u = 0; u < csr.numNodes(); u++) {
+            lookups = lookups && csr.denseId(csr.nodeId(u)) == u && csr.locate(csr.coord(u)) == u;
+        }
+        assertTest(lookups);
+        assertTest(meanEdgeSpan(csr) * 10 < meanEdgeSpan(byId));
+
+        // routes between the same coordinates weigh the same
+        bool sameRoutes = true;
+        srand(271);
+        for (int i = 0; i < 50; i++) {
+            int s = rand() % byId.numNodes();
+            int t = rand() % byId.numNodes();
+            double expected = byId.dijkstras(s, t, ws);
+            Route<long long> route = scrambled.shortestRoute(byId.coord(s), byId.coord(t));
+            sameRoutes = sameRoutes && fabs(route.weight - expected) < 1e-6 && route.ids.front() == byId.nodeId(s);
+        }
+        assertTest(sameRoutes);
+    }
+
+    // a reordered graph keeps its ID lookup through a binary file,
+    // and ID_ORDER puts the IDs back in order
+    scrambled.setNodeOrder(HILBERT_ORDER);
+    scrambled.writeBinary("order.bin.tmp");
+    WeightedGraph<long long> mapped = WeightedGraph<long long>::readFromBinary("order.bin.tmp");
+    bool mappedLookups = true;
+    for (int u = 0; u < byId.numNodes(); u++) {
+        mappedLookups = mappedLookups && mapped.freeze().nodeId(mapped.freeze().denseId(byId.nodeId(u))) == byId.nodeId(u);
+    }
+    assertTest(mappedLookups && mapped.freeze().denseId(-5) == -1);
+    remove("order.bin.tmp");
+
+    scrambled.setNodeOrder(ID_ORDER);
+    bool sorted = true;
+    for (int u = 0; u + 1 < scrambled.freeze().numNodes(); u++) {
+        sorted = sorted && scrambled.freeze().nodeId(u) < scrambled.freeze().nodeId(u + 1);
+    }
+    assertTest(sorted);
+}
+
+void testCompressedGraph() {
+    WeightedGraph<long long> campus = WeightedGraph<long long>::readFromFile("denison.out");
+    WeightedGraph<long long> grid = makeGridGraph(40, 40, 271);
+    grid.setNodeOrder(HILBERT_ORDER);
+    SearchWorkspace ws, cws;
+
+    for (WeightedGraph<long long>* graph : {&campus, &grid}) {
+        const CSRGraph<long long>& csr = graph->freeze();
+        for (WeightFormat format : {FLOAT_WEIGHTS, FIXED_WEIGHTS}) {
+            CompressedGraph<long long> compressed(csr, format, 0.01);
+
+            // every edge decodes to its target, with the weight off by
+            // no more than the reported error, which stays in bounds
+            bool edgesMatch = compressed.numNodes() == csr.numNodes() && compressed.numEdges() == csr.numEdges();
+            double worst = 0;
+            for (int u = 0; u < csr.numNodes(); u++) {
+                int e = csr.edgeBegin(u);
+                compressed.forEachEdge(u, [&](int v, double w) {
+                    edgesMatch = edgesMatch && e < csr.edgeEnd(u) && v == csr.target(e);
+                    worst = max(worst, fabs(w - csr.weight(e)));
+                    e++;
+                });
+                edgesMatch = edgesMatch && e == csr.edgeEnd(u) && compressed.nodeId(u) == csr.nodeId(u);
+            }
+            assertTest(edgesMatch && worst == compressed.maxWeightError());
+            assertTest(format == FIXED_WEIGHTS ? compressed.maxWeightError() <= 0.005 + 1e-9
+                                               : compressed.maxRelativeError() <= 6e-8);
+
+            // distances differ by at most the error times the hops of
+            // either shortest path
+            bool closeEnough = true;
+            srand(271);
+            for (int i = 0; i < 50; i++) {
+                int s = rand() % csr.numNodes();
+                int t = rand() % csr.numNodes();
+                double exact = csr.dijkstras(s, t, ws);
+                double approx = compressed.dijkstras(s, t, cws);
+                if (exact == numeric_limits<double>::infinity()) {
+                    closeEnough = closeEnough && approx == exact;
+                    continue;
+                }
+                double hops = max(ws.path(t).size(), cws.path(t).size());
+                closeEnough = closeEnough && fabs(exact - approx) <= hops * compressed.maxWeightError() + 1e-9;
+            }
+            assertTest(closeEnough);
+        }
+    }
+
+    bool badStep = false;
+    try {
+        CompressedGraph<long long> compressed(campus.freeze(), FIXED_WEIGHTS, 0);
+    } catch (const invalid_argument&) {
+        badStep = true;
+    }
+    assertTest(badStep);
+}
+
 void runTests() {
     cout << "\n>>Running tests..." << endl;
     testPQInsert();
     testPQDecreaseKey();
     testPQExtractMin();
+    testPQAssign();
+    testIndexedPQ();
+    testPairingHeap();
+    testMonotoneQueues();
     testWGReadFromFile();
     testWGAddVertex();
     testWGAddEdge();
     testWGEdgeIn();
     testWGDijkstras();
     testWGfindNodes();
+    testWGNearestNode();
+    testKDTree();
+    testCSRFreeze();
+    testCSRDijkstras();
+    testCSRDijkstrasStopsEarly();
+    testCSRReverseEdges();
+    testWorkspaceReuse();
+    testShortestRoute();
+    testRouteServer();
+    testRouteCache();
+    testBidirectionalDijkstras();
+    testAStar();
+    testContractionHierarchy();
+    testDistanceMatrix();
+    testOneToAll();
+    testDynamicShortestPaths();
+    testKShortestPaths();
+    testDeltaStepping();
+    testNodeOrder();
+    testCompressedGraph();
+    testGraphParser();
+    testParallelLoader();
+    testBinaryGraphFile();
     cout <<
     "\n>>Test Resuts<<" <<
     "\nTests Passed: " << testsPassed <<
@@ -143,6 +1529,576 @@ void runTests() {
 }
 
 
+// Benchmark functions declared here
+//============================================================
+// Times one call of a function in microseconds
+template <typename F>
+double timeMicros(F function) {
+    chrono::time_point<chrono::high_resolution_clock> start = chrono::high_resolution_clock::now();
+    function();
+    chrono::time_point<chrono::high_resolution_clock> end = chrono::high_resolution_clock::now();
+    chrono::duration<double, std::micro> diff = end - start;
+    return diff.count();
+}
+
+void benchContractionHierarchy(const string& name, WeightedGraph<long long>& graph) {
+    const int queries = 200;
+    vector<pair<double, double> > picks = randomCoords(graph.freeze(), 2 * queries, 271);
+
+    double preprocess = timeMicros([&]() { graph.contract(); });
+
+    double dijkstraTime = 0, chTime = 0;
+    long dijkstraSettled = 0, chSettled = 0;
+    for (int i = 0; i < queries; i++) {
+        dijkstraTime += timeMicros([&]() { graph.dijkstras(picks[2 * i], picks[2 * i + 1]); });
+        dijkstraSettled += graph.getSettled();
+        chTime += timeMicros([&]() { graph.contractionHierarchyQuery(picks[2 * i], picks[2 * i + 1]); });
+        chSettled += graph.getSettled();
+    }
+
+    cout << name << ": " << graph.freeze().numNodes() << " nodes, "
+         << graph.contract().numShortcuts() << " shortcuts, preprocessing " << preprocess / 1000 << " ms" << endl;
+    cout << "    dijkstras():  " << dijkstraTime / queries << " us/query, "
+         << dijkstraSettled / queries << " settled/query" << endl;
+    cout << "    CH query:     " << chTime / queries << " us/query, "
+         << chSettled / queries << " settled/query" << endl;
+}
+
+// Writes a graph in the text format read by readFromFile
+void writeTextGraph(const string& filename, const CSRGraph<long long>& csr) {
+    ofstream file(filename);
+    file.precision(17);
+    file << csr.numNodes() << " " << csr.numEdges() << "\n";
+    for (int u = 0; u < csr.numNodes(); u++) {
+        file << csr.nodeId(u) << " " << csr.coord(u).first << " " << csr.coord(u).second << "\n";
+    }
+    for (int u = 0; u < csr.numNodes(); u++) {
+        for (int e = csr.edgeBegin(u); e < csr.edgeEnd(u); e++) {
+            file << csr.nodeId(u) << " " << csr.nodeId(csr.target(e)) << " " << csr.weight(e) << "\n";
+        }
+    }
+}
+
+void benchGraphLoading(int side) {
+    WeightedGraph<long long> grid = makeGridGraph(side, side, 271);
+    writeTextGraph("bench.txt.tmp", grid.freeze());
+    grid.writeBinary("bench.bin.tmp");
+
+    double textTime = timeMicros([&]() { WeightedGraph<long long>::readFromFile("bench.txt.tmp"); });
+    double parallelTimes[3];
+    for (int i = 0; i < 3; i++) {
+        parallelTimes[i] = timeMicros([&]() { WeightedGraph<long long>::readFromFileParallel("bench.txt.tmp", 1 << i); });
+    }
+    double binaryTime = timeMicros([&]() { WeightedGraph<long long>::readFromBinary("bench.bin.tmp"); });
+    double unverifiedTime = timeMicros([&]() { WeightedGraph<long long>::readFromBinary("bench.bin.tmp", false); });
+
+    cout << side << "x" << side << " grid: " << grid.freeze().numNodes() << " nodes, "
+         << grid.freeze().numEdges() << " edges" << endl;
+    cout << "    text file (sequential):  " << textTime / 1000 << " ms" << endl;
+    for (int i = 0; i < 3; i++) {
+        cout << "    text file (" << (1 << i) << " thread" << (i == 0 ? "):   " : "s):  ") << parallelTimes[i] / 1000 << " ms" << endl;
+    }
+    cout << "    binary file (verified):  " << binaryTime / 1000 << " ms" << endl;
+    cout << "    binary file (mmap only): " << unverifiedTime / 1000 << " ms" << endl;
+    remove("bench.txt.tmp");
+    remove("bench.bin.tmp");
+}
+
+void benchDistanceMatrix(int side, int count) {
+    WeightedGraph<long long> grid = makeGridGraph(side, side, 271);
+    vector<pair<double, double> > picks = randomCoords(grid.freeze(), 2 * count, 271);
+    vector<pair<double, double> > sources(picks.begin(), picks.begin() + count);
+    vector<pair<double, double> > destinations(picks.begin() + count, picks.end());
+
+    double cellTime = timeMicros([&]() {
+        for (const pair<double, double>& s : sources) {
+            for (const pair<double, double>& d : destinations) {
+                grid.dijkstras(s, d);
+            }
+        }
+    });
+    double matrixTime = timeMicros([&]() { grid.distanceMatrix(sources, destinations, 1); });
+    double parallelTime = timeMicros([&]() { grid.distanceMatrix(sources, destinations); });
+
+    cout << count << "x" << count << " matrix on " << side << "x" << side << " grid, "
+         << thread::hardware_concurrency() << " cores" << endl;
+    cout << "    dijkstras() per cell:       " << cellTime / 1000 << " ms" << endl;
+    cout << "    distanceMatrix, 1 thread:   " << matrixTime / 1000 << " ms" << endl;
+    cout << "    distanceMatrix, all cores:  " << parallelTime / 1000 << " ms" << endl;
+}
+
+// Runs the same random insert / decreaseKey / extractMin mix on a
+// priority queue and returns the time it took
+template <typename Q>
+double timeQueueOperations(Q& queue, int n) {
+    srand(271);
+    return timeMicros([&]() {
+        for (int i = 0; i < n; i++) {
+            queue.insert(i, rand() % 100000);
+            int handle = rand() % (i + 1);
+            if (queue.contains(handle)) {
+                queue.decreaseKey(handle, rand() % 100000);
+            }
+            if (i % 2 == 0) {
+                queue.extractMin();
+            }
+        }
+        while (!queue.isEmpty()) {
+            queue.extractMin();
+        }
+    });
+}
+
+void benchPriorityQueues(int n) {
+    PriorityQueue<int> hashed;
+    IndexedPriorityQueue<> indexed(n);
+    double hashedTime = timeQueueOperations(hashed, n);
+    double indexedTime = timeQueueOperations(indexed, n);
+    cout << n << " inserts with decreaseKey and extractMin" << endl;
+    cout << "    PriorityQueue<int>:    " << hashedTime / 1000 << " ms" << endl;
+    cout << "    IndexedPriorityQueue:  " << indexedTime / 1000 << " ms" << endl;
+}
+
+void benchHeapify(int n) {
+    vector<pair<int, double> > items(n);
+    srand(271);
+    for (int i = 0; i < n; i++) {
+        items[i] = make_pair(i, rand() % 1000000);
+    }
+
+    PriorityQueue<int> inserted;
+    double insertTime = timeMicros([&]() {
+        for (const pair<int, double>& item : items) {
+            inserted.insert(item.first, item.second);
+        }
+    });
+    PriorityQueue<int> built;
+    double assignTime = timeMicros([&]() { built.assign(items); });
+    cout << n << " initial items" << endl;
+    cout << "    insert one at a time:  " << insertTime / 1000 << " ms" << endl;
+    cout << "    assign (heapify):      " << assignTime / 1000 << " ms" << endl;
+}
+
+// One priority queue call made by a search: 'c'lear, 'i'nsert,
+// 'd'ecreaseKey or e'x'tractMin
+struct QueueOp {
+    char    type;
+    int     handle;
+    double  priority;
+};
+
+// Appends the queue calls CSRGraph::dijkstras makes for one query.
+// Returns the number of extractMin calls so the caller can check
+// them against the real search.
+int recordDijkstraTrace(const CSRGraph<long long>& csr, int source, int target, vector<QueueOp>& trace) {
+    vector<double> dist(csr.numNodes(), numeric_limits<double>::infinity());
+    IndexedPriorityQueue<> queue(csr.numNodes());
+    int settled = 0;
+    trace.push_back({'c', 0, 0});
+    dist[source] = 0;
+    queue.insert(source, 0);
+    trace.push_back({'i', source, 0});
+    while (!queue.isEmpty()) {
+        auto [current, currentDist] = queue.extractMin();
+        trace.push_back({'x', 0, 0});
+        settled++;
+        if (current == target) {
+            break;
+        }
+        for (int e = csr.edgeBegin(current); e < csr.edgeEnd(current); e++) {
+            int neighbor = csr.target(e);
+            double newDist = currentDist + csr.weight(e);
+            if (dist[neighbor] == numeric_limits<double>::infinity()) {
+                dist[neighbor] = newDist;
+                queue.insert(neighbor, newDist);
+                trace.push_back({'i', neighbor, newDist});
+            }
+            else if (dist[neighbor] > newDist) {
+                dist[neighbor] = newDist;
+                queue.decreaseKey(neighbor, newDist);
+                trace.push_back({'d', neighbor, newDist});
+            }
+        }
+    }
+    return settled;
+}
+
+// Replays a recorded trace on a queue and returns the time it took
+template <typename Q>
+double replayTrace(Q& queue, const vector<QueueOp>& trace) {
+    return timeMicros([&]() {
+        for (const QueueOp& op : trace) {
+            switch (op.type) {
+                case 'c': queue.clear(); break;
+                case 'i': queue.insert(op.handle, op.priority); break;
+                case 'd': queue.decreaseKey(op.handle, op.priority); break;
+                default:  queue.extractMin(); break;
+            }
+        }
+    });
+}
+
+void benchHeapArity(const string& name, const CSRGraph<long long>& csr, int queries) {
+    vector<QueueOp> trace;
+    SearchWorkspace ws;
+    bool traceMatches = true;
+    srand(271);
+    for (int i = 0; i < queries; i++) {
+        int s = rand() % csr.numNodes();
+        int t = rand() % csr.numNodes();
+        csr.dijkstras(s, t, ws);
+        traceMatches = traceMatches && recordDijkstraTrace(csr, s, t, trace) == ws.settled;
+    }
+    if (!traceMatches) {
+        cout << "    (warning: recorded trace does not match dijkstras())" << endl;
+    }
+
+    int n = csr.numNodes();
+    IndexedPriorityQueue<2> indexed2(n);
+    IndexedPriorityQueue<4> indexed4(n);
+    IndexedPriorityQueue<8> indexed8(n);
+    PriorityQueue<int, 2> hashed2;
+    PriorityQueue<int, 4> hashed4;
+    PriorityQueue<int, 8> hashed8;
+    ios format(nullptr);
+    format.copyfmt(cout);
+    cout << fixed << setprecision(1);
+    cout << name << ": " << queries << " dijkstras() queries, " << trace.size() << " queue calls" << endl;
+    cout << "    arity                        2          4          8" << endl;
+    cout << "    IndexedPriorityQueue:  " << setw(7) << replayTrace(indexed2, trace) / 1000 << " ms "
+         << setw(7) << replayTrace(indexed4, trace) / 1000 << " ms " << setw(7) << replayTrace(indexed8, trace) / 1000 << " ms" << endl;
+    cout << "    PriorityQueue<int>:    " << setw(7) << replayTrace(hashed2, trace) / 1000 << " ms "
+         << setw(7) << replayTrace(hashed4, trace) / 1000 << " ms " << setw(7) << replayTrace(hashed8, trace) / 1000 << " ms" << endl;
+    cout.copyfmt(format);
+}
+
+void benchPairingHeap(const string& name, const CSRGraph<long long>& csr, int queries) {
+    vector<QueueOp> trace;
+    srand(271);
+    for (int i = 0; i < queries; i++) {
+        recordDijkstraTrace(csr, rand() % csr.numNodes(), rand() % csr.numNodes(), trace);
+    }
+    int decreases = 0;
+    for (const QueueOp& op : trace) {
+        decreases += op.type == 'd';
+    }
+
+    PriorityQueue<int> binary;
+    PairingHeap<int> pairing;
+    cout << name << ": " << queries << " dijkstras() queries, " << trace.size() << " queue calls, "
+         << decreases << " decreaseKey" << endl;
+    cout << "    PriorityQueue<int>:    " << replayTrace(binary, trace) / 1000 << " ms" << endl;
+    cout << "    PairingHeap<int>:      " << replayTrace(pairing, trace) / 1000 << " ms" << endl;
+}
+
+void benchQueueTypes(const string& name, WeightedGraph<long long>& graph, int queries) {
+    vector<pair<double, double> > picks = randomCoords(graph.freeze(), 2 * queries, 271);
+    cout << name << ": " << queries << " dijkstras() queries" << endl;
+    const char* names[] = {"binary heap:  ", "radix heap:   ", "Dial buckets: "};
+    for (QueueType type : {BINARY_HEAP, RADIX_HEAP, DIAL_BUCKETS}) {
+        graph.setQueueType(type, 10.0);
+        double time = timeMicros([&]() {
+            for (int i = 0; i < queries; i++) {
+                graph.dijkstras(picks[2 * i], picks[2 * i + 1]);
+            }
+        });
+        cout << "    " << names[type] << time / queries << " us/query" << endl;
+    }
+    graph.setQueueType(BINARY_HEAP);
+}
+
+void benchRouteServer(int queries) {
+    WeightedGraph<long long> graph = WeightedGraph<long long>::readFromFile("denison.out");
+    vector<pair<double, double> > picks = randomCoords(graph.freeze(), 2 * queries, 271);
+    stringstream text;
+    text << setprecision(17);
+    for (int i = 0; i < queries; i++) {
+        text << picks[2 * i].first << " " << picks[2 * i].second << " "
+             << picks[2 * i + 1].first << " " << picks[2 * i + 1].second << "\n";
+    }
+
+    cout << queries << " queries on denison.out" << endl;
+    vector<int> threadCounts = {1};
+    if (threadCount(0) > 1) {
+        threadCounts.push_back(threadCount(0));
+    }
+    for (int threads : threadCounts) {
+        RouteServer<long long> server(graph, threads);
+        stringstream in(text.str());
+        stringstream out;
+        double time = timeMicros([&]() { server.serve(in, out); });
+        cout << "    " << threads << " thread(s): " << queries / (time / 1e6) << " queries/s" << endl;
+    }
+}
+
+void benchDynamicShortestPaths(int side, int sources, int updates) {
+    WeightedGraph<long long> graph = makeGridGraph(side, side, 271);
+    const CSRGraph<long long>& csr = graph.freeze();
+    DynamicShortestPaths<long long> dynamic(csr);
+    srand(271);
+    for (int i = 0; i < sources; i++) {
+        dynamic.pin(csr.nodeId(rand() % csr.numNodes()));
+    }
+
+    // each update scales a random edge by 0.5x to 1.5x
+    vector<pair<int, double> > changes;
+    for (int i = 0; i < updates; i++) {
+        int e = rand() % csr.numEdges();
+        changes.push_back(make_pair(e, csr.weight(e) * (0.5 + rand() % 100 / 100.0)));
+    }
+    vector<int> tails(csr.numEdges());
+    for (int u = 0; u < csr.numNodes(); u++) {
+        for (int e = csr.edgeBegin(u); e < csr.edgeEnd(u); e++) {
+            tails[e] = u;
+        }
+    }
+
+    long long work = 0;
+    double repairTime = timeMicros([&]() {
+        for (pair<int, double> change : changes) {
+            dynamic.setWeight(csr.nodeId(tails[change.first]), csr.nodeId(csr.target(change.first)), change.second);
+            work += dynamic.lastUpdateWork();
+        }
+    });
+    SearchWorkspace ws;
+    vector<double> distances;
+    vector<int> parents;
+    double recomputeTime = timeMicros([&]() {
+        for (int i = 0; i < updates; i++) {
+            for (int s = 0; s < sources; s++) {
+                csr.oneToAll(s, numeric_limits<double>::infinity(), ws, distances, parents);
+            }
+        }
+    });
+
+    cout << side << "x" << side << " grid, " << sources << " pinned sources, " << updates << " weight changes" << endl;
+    cout << "    repair trees:      " << repairTime / updates << " us/update, " << work / updates << " nodes touched" << endl;
+    cout << "    recompute trees:   " << recomputeTime / updates << " us/update, " << sources * csr.numNodes() << " nodes" << endl;
+}
+
+void benchKShortestPaths(const string& name, const CSRGraph<long long>& csr, int queries) {
+    srand(271);
+    vector<pair<int, int> > pairs;
+    for (int i = 0; i < queries; i++) {
+        pairs.push_back(make_pair(rand() % csr.numNodes(), rand() % csr.numNodes()));
+    }
+
+    SearchWorkspace ws;
+    double single = timeMicros([&]() {
+        for (pair<int, int> query : pairs) {
+            csr.dijkstras(query.first, query.second, ws);
+        }
+    });
+    cout << name << ", " << queries << " queries" << endl;
+    cout << "    one dijkstras():   " << single / queries << " us/query" << endl;
+    for (int threads : {1, 4}) {
+        KShortestPaths<long long> yen(csr, threads);
+        for (int k : {1, 3, 5}) {
+            double time = timeMicros([&]() {
+                for (pair<int, int> query : pairs) {
+                    yen.find(query.first, query.second, k);
+                }
+            });
+            cout << "    k = " << k << ", " << threads << " thread" << (threads == 1 ? ": " : "s:") << "    " << time / queries << " us/query" << endl;
+        }
+    }
+}
+
+void benchDeltaStepping(const string& name, const CSRGraph<long long>& csr, int runs) {
+    vector<int> sources;
+    srand(271);
+    for (int i = 0; i < runs; i++) {
+        sources.push_back(rand() % csr.numNodes());
+    }
+    SearchWorkspace ws;
+    vector<double> distances;
+    vector<int> parents;
+    double sequential = timeMicros([&]() {
+        for (int source : sources) {
+            csr.oneToAll(source, numeric_limits<double>::infinity(), ws, distances, parents);
+        }
+    });
+    cout << name << ", " << runs << " full searches" << endl;
+    cout << "    oneToAll(): " << sequential / runs / 1000 << " ms/search" << endl;
+
+    DeltaStepping<long long> engine(csr, 1);
+    double meanDelta = engine.getDelta();
+    for (double delta : {meanDelta / 4, meanDelta, meanDelta * 4}) {
+        engine.setDelta(delta);
+        double time = timeMicros([&]() {
+            for (int source : sources) {
+                engine.run(source, distances);
+            }
+        });
+        cout << "    delta " << delta << ", 1 thread: " << time / runs / 1000 << " ms/search, "
+             << engine.lastPhaseCount() << " phases" << endl;
+    }
+    for (int threads = 2; threads <= max(4, threadCount(0)); threads *= 2) {
+        DeltaStepping<long long> parallel(csr, threads);
+        double time = timeMicros([&]() {
+            for (int source : sources) {
+                parallel.run(source, distances);
+            }
+        });
+        cout << "    default delta, " << threads << " threads: " << time / runs / 1000 << " ms/search" << endl;
+    }
+}
+
+void benchNodeOrder(int side, int queries) {
+    WeightedGraph<long long> grid = makeGridGraph(side, side, 271);
+    WeightedGraph<long long> graph = scrambleIds(grid, 271);
+    vector<pair<double, double> > picks = randomCoords(graph.freeze(), 2 * queries, 271);
+    cout << side << "x" << side << " grid with shuffled IDs, " << queries << " queries" << endl;
+
+    const char* names[] = {"ID order:     ", "Hilbert order:", "RCM order:    "};
+    for (NodeOrder order : {ID_ORDER, HILBERT_ORDER, RCM_ORDER}) {
+        double reorderTime = timeMicros([&]() { graph.setNodeOrder(order); });
+        const CSRGraph<long long>& csr = graph.freeze();
+
+        // share of edges whose ends sit in the same 64-byte line or
+        // 4 KB page of an array of doubles indexed by node
+        long long sameLine = 0, samePage = 0;
+        for (int u = 0; u < csr.numNodes(); u++) {
+            for (int e = csr.edgeBegin(u); e < csr.edgeEnd(u); e++) {
+                sameLine += u / 8 == csr.target(e) / 8;
+                samePage += u / 512 == csr.target(e) / 512;
+            }
+        }
+
+        SearchWorkspace ws;
+        vector<int> ends;
+        for (pair<double, double> pick : picks) {
+            ends.push_back(csr.locate(pick));
+        }
+        double queryTime = timeMicros([&]() {
+            for (int i = 0; i < queries; i++) {
+                csr.dijkstras(ends[2 * i], ends[2 * i + 1], ws);
+            }
+        });
+        vector<double> distances;
+        vector<int> parents;
+        double allTime = timeMicros([&]() {
+            csr.oneToAll(ends[0], numeric_limits<double>::infinity(), ws, distances, parents);
+        });
+
+        cout << "    " << names[order] << " " << queryTime / queries / 1000 << " ms/query, "
+             << allTime / 1000 << " ms one-to-all, edge span " << meanEdgeSpan(csr) << ", "
+             << 100.0 * sameLine / csr.numEdges() << "% same line, "
+             << 100.0 * samePage / csr.numEdges() << "% same page";
+        if (order != ID_ORDER) {
+            cout << ", reordered in " << reorderTime / 1000 << " ms";
+        }
+        cout << endl;
+    }
+}
+
+void benchCompressedGraph(const string& name, WeightedGraph<long long>& graph, int queries) {
+    const CSRGraph<long long>& csr = graph.freeze();
+    double m = csr.numEdges();
+
+    // the hash maps are weighed by the bytes a copy of them asks for
+    long long before = allocatedBytes;
+    unordered_map<long long, unordered_map<long long, double> > copy = graph.getAdjacencyList();
+    double mapBytes = allocatedBytes - before;
+    double forwardBytes = (csr.numNodes() + 1) * sizeof(int) + m * (sizeof(int) + sizeof(double));
+
+    srand(271);
+    vector<pair<int, int> > pairs;
+    for (int i = 0; i < queries; i++) {
+        pairs.push_back(make_pair(rand() % csr.numNodes(), rand() % csr.numNodes()));
+    }
+    SearchWorkspace ws;
+    double csrTime = timeMicros([&]() {
+        for (pair<int, int> query : pairs) {
+            csr.dijkstras(query.first, query.second, ws);
+        }
+    });
+
+    cout << name << ", " << csr.numEdges() << " edges, " << queries << " queries" << endl;
+    cout << "    hash maps:        " << mapBytes / m << " bytes/edge" << endl;
+    cout << "    CSR, forward:     " << forwardBytes / m << " bytes/edge, " << csrTime / queries << " us/query" << endl;
+    cout << "    CSR, both ways:   " << 2 * forwardBytes / m << " bytes/edge" << endl;
+    for (WeightFormat format : {FLOAT_WEIGHTS, FIXED_WEIGHTS}) {
+        CompressedGraph<long long> compressed(csr, format, 0.01);
+        double time = timeMicros([&]() {
+            for (pair<int, int> query : pairs) {
+                compressed.dijkstras(query.first, query.second, ws);
+            }
+        });
+        cout << (format == FLOAT_WEIGHTS ? "    float weights:    " : "    fixed 0.01:       ")
+             << compressed.edgeBytes() / m << " bytes/edge, " << time / queries << " us/query, max error "
+             << compressed.maxWeightError() << " (" << compressed.maxRelativeError() * 100 << "%)" << endl;
+    }
+}
+
+void runBenchmarks() {
+    cout << "\n>>Running benchmarks..." << endl;
+
+    cout << "\n-- Hash-indexed vs array-indexed priority queue --" << endl;
+    benchPriorityQueues(1000000);
+
+    cout << "\n-- Loading a priority queue one by one vs in bulk --" << endl;
+    benchHeapify(1000000);
+
+    cout << "\n-- Heap arity on recorded dijkstras() queue traces --" << endl;
+    benchHeapArity("denison.out", WeightedGraph<long long>::readFromFile("denison.out").freeze(), 2000);
+    benchHeapArity("300x300 grid", makeGridGraph(300, 300, 271).freeze(), 200);
+
+    cout << "\n-- Binary heap vs pairing heap on dijkstras() queue traces --" << endl;
+    benchPairingHeap("denison.out", WeightedGraph<long long>::readFromFile("denison.out").freeze(), 2000);
+    benchPairingHeap("2000 nodes, degree 100", makeDenseGraph(2000, 100, 271).freeze(), 50);
+    benchPairingHeap("10000 nodes, degree 200", makeDenseGraph(10000, 200, 271).freeze(), 10);
+
+    cout << "\n-- dijkstras() with each queue type --" << endl;
+    WeightedGraph<long long> queueCampus = WeightedGraph<long long>::readFromFile("denison.out");
+    benchQueueTypes("denison.out", queueCampus, 2000);
+    WeightedGraph<long long> queueGrid = makeGridGraph(300, 300, 271);
+    benchQueueTypes("300x300 grid", queueGrid, 200);
+
+    cout << "\n-- Repairing pinned shortest path trees vs recomputing them --" << endl;
+    benchDynamicShortestPaths(300, 4, 50);
+
+    cout << "\n-- k shortest loopless paths vs one dijkstras() --" << endl;
+    benchKShortestPaths("denison.out", WeightedGraph<long long>::readFromFile("denison.out").freeze(), 200);
+    benchKShortestPaths("100x100 grid", makeGridGraph(100, 100, 271).freeze(), 20);
+
+    cout << "\n-- Delta stepping vs sequential one-to-all, " << threadCount(0) << " core(s) --" << endl;
+    benchDeltaStepping("denison.out", WeightedGraph<long long>::readFromFile("denison.out").freeze(), 50);
+    benchDeltaStepping("300x300 grid", makeGridGraph(300, 300, 271).freeze(), 10);
+
+    cout << "\n-- Node order of the frozen graph --" << endl;
+    benchNodeOrder(300, 200);
+    benchNodeOrder(700, 40);
+
+    cout << "\n-- Compressed adjacency vs hash maps and CSR --" << endl;
+    WeightedGraph<long long> compressCampus = WeightedGraph<long long>::readFromFile("denison.out");
+    benchCompressedGraph("denison.out", compressCampus, 2000);
+    WeightedGraph<long long> compressGrid = makeGridGraph(300, 300, 271);
+    WeightedGraph<long long> scrambledGrid = scrambleIds(compressGrid, 271);
+    benchCompressedGraph("300x300 grid, shuffled IDs", scrambledGrid, 100);
+    scrambledGrid.setNodeOrder(HILBERT_ORDER);
+    benchCompressedGraph("300x300 grid, Hilbert order", scrambledGrid, 100);
+
+    cout << "\n-- Route server batch throughput --" << endl;
+    benchRouteServer(20000);
+
+    cout << "\n-- Contraction hierarchy vs dijkstras() --" << endl;
+    WeightedGraph<long long> campus = WeightedGraph<long long>::readFromFile("denison.out");
+    benchContractionHierarchy("denison.out", campus);
+    for (int side : {50, 100}) {
+        WeightedGraph<long long> grid = makeGridGraph(side, side, 271);
+        benchContractionHierarchy(to_string(side) + "x" + to_string(side) + " grid", grid);
+    }
+
+    cout << "\n-- Distance matrix vs one dijkstras() per cell --" << endl;
+    benchDistanceMatrix(100, 50);
+
+    cout << "\n-- Text vs binary graph loading --" << endl;
+    benchGraphLoading(500);
+    cout << "------------------------------------";
+}
+
+
 // CLI function declared here
 //============================================================
 void CLIfunction() {
@@ -167,6 +2123,8 @@ void CLIfunction() {
         }
 
         bool run = true; // Boolean to control while loop.
+        SearchWorkspace queryWorkspace;  // kept across queries so they reuse memory
+        Route<long long> shortest;
         // CLI interface
         while (true) {
             double x_1, y_1, x_2, y_2;
@@ -187,7 +2145,8 @@ void CLIfunction() {
             pair<double, double> start = make_pair(x_1, y_1);
             // Loop until valid coordinates are input or program is quit
             while (graph.idFromCoords(start) == -1) {
-                cout << "Cannot find coordinates..." << endl;
+                pair<double, double> closest = graph.nearestNode(start);
+                cout << "Cannot find coordinates... the closest node is (" << closest.first << ", " << closest.second << ")" << endl;
                 cout << "Re-enter a start coordinate (formatted as 'x y') or 'q' to quit: ";
                 getline(cin, coord);
                 if (coord == "q") {
@@ -217,7 +2176,8 @@ void CLIfunction() {
             pair<double, double> end = make_pair(x_2, y_2);
             // Loop until valid coordinates are input or program is quit
             while (graph.idFromCoords(end) == -1) {
-                cout << "Cannot find coordinates..." << endl;
+                pair<double, double> closest = graph.nearestNode(end);
+                cout << "Cannot find coordinates... the closest node is (" << closest.first << ", " << closest.second << ")" << endl;
                 cout << "Re-enter an end coordinate (formatted as 'x y') or 'q' to quit: ";
                 getline(cin, coord);
                 if (coord == "q") {
@@ -236,40 +2196,21 @@ void CLIfunction() {
             cout << "End node found!" << endl;
 
             try {
-                vector<pair< double, double> > shortest = graph.dijkstras(start, end);
-
-                // loop to calculate weight of shortest path
-                double weight = 0;
-                unordered_map<long long, unordered_map<long long, double > > list = graph.getAdjacencyList();
-                for (int i = 0; i < shortest.size() - 1; i++) {
-                    pair<double, double> current = shortest[i];
-                    pair<double, double> next = shortest[i + 1]; 
-                    long node, nextNode;
-                    for (const auto& [id, coord] : graph.getCoords()) {        
-                        if (coord.first == current.first && coord.second == current.second) {
-                            node = id;
-                        }
-                        if (coord.first == next.first && coord.second == next.second) {
-                            nextNode = id;
-                        }
-                    }
-
-                    weight += list[node][nextNode];
-                }
+                graph.dijkstras(start, end, queryWorkspace, shortest);
                 
                 // loop to iterate through the shortest path list and print out the coordinates
-                if (weight == 0) {
+                if (shortest.ids.size() < 2) {
                     cout << "No path between these points" << endl;
                 } else {
                     cout << "The shortest path from (" << start.first << ", " << start.second << ") to (" << end.first << ", " << end.second << ") is: "  << endl;
-                    for (int i = 0; i < shortest.size(); i++) {
-                        if (i == shortest.size() - 1) {
-                            cout << "(" << shortest[i].first << ", " << shortest[i].second << ")";
+                    for (size_t i = 0; i < shortest.coords.size(); i++) {
+                        if (i == shortest.coords.size() - 1) {
+                            cout << "(" << shortest.coords[i].first << ", " << shortest.coords[i].second << ")";
                         } else {
-                            cout << "(" << shortest[i].first << ", " << shortest[i].second << ") -> ";
+                            cout << "(" << shortest.coords[i].first << ", " << shortest.coords[i].second << ") -> ";
                         }
                     }
-                    cout << " with a weight of: " << weight << endl;
+                    cout << " with a weight of: " << shortest.weight << endl;
                 }
             } catch (const invalid_argument& e) {
                 cout << "Error: " << e.what() << endl;
@@ -281,14 +2222,50 @@ void CLIfunction() {
     }
 }
 //=============================================================
+// serveMain
+// INPUTS: Command line arguments, argv[1] being "--serve"
+// OUTPUTS: Exit status, 1 if the graph or queries can't be read
+// Batch/server mode: answers route queries without the prompt
+//   ./mytests --serve <graph file> [queries file | - | unix:<socket path>] [threads]
+// Queries come from stdin when no source (or "-") is given.
+//=============================================================
+int serveMain(int argc, char* argv[]) {
+    if (argc < 3) {
+        cerr << "usage: " << argv[0] << " --serve <graph file> [queries file | - | unix:<socket path>] [threads]" << endl;
+        return 1;
+    }
+    string source = argc > 3 ? argv[3] : "-";
+    int threads = argc > 4 ? atoi(argv[4]) : 0;
+    try {
+        RouteServer<long long> server(argv[2], threads);
+        ios::sync_with_stdio(false);
+        if (source.rfind("unix:", 0) == 0) {
+            server.serveSocket(source.substr(5));
+        }
+        else if (source == "-") {
+            server.serve(cin, cout, isatty(STDIN_FILENO));
+        }
+        else {
+            server.serveFile(source, cout);
+        }
+    } catch (const exception& e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
+//=============================================================
 // CLI function (change from main to other name)
-int main (void) {
+int main (int argc, char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "--serve") {
+        return serveMain(argc, argv);
+    }
     cout << "\n\n=== Welcome to Denison Route Finder! ===" << endl;
     while (true) {
         cout << 
         "\nNotice: You may input \'q\' at anytime to terminate this program." <<
         "\nWould you like to run the CLI program or test it? " <<
-        "\nType \"test\" to run tests, any other input will run CLI: ";
+        "\nType \"test\" to run tests, \"bench\" to run benchmarks, any other input will run CLI: ";
         string filename;
         getline(cin, filename); //using getline and cin together causes issues, unify.
 
@@ -300,6 +2277,9 @@ int main (void) {
             runTests();
             
         }
+        else if (filename == "bench") {
+            runBenchmarks();
+        }
         else {
             CLIfunction();
             break;
@@ -0,0 +1,269 @@
+//=========================================================
+// PairingHeap.cpp
+// Andrew McCutchan, Namu Kim
+// Implementaiton file for PairingHeap class
+// 12/18/2024
+//=========================================================
+
+#include "pairingHeap.hpp"
+
+//==============================================================
+// Default Constructor
+// INPUTS: NONE
+// OUTPUTS: NONE
+// Creates an empty pairing heap
+//==============================================================
+template <class T>
+PairingHeap<T>::PairingHeap() {
+    tableBits = 0;
+    queued = 0;
+    root = -1;
+}
+
+//==============================================================
+// clear
+// INPUTS: NONE
+// OUTPUTS: NONE
+// Empties the heap. The node pool and the index keep their
+// memory for reuse.
+//==============================================================
+template <class T>
+void PairingHeap<T>::clear() {
+    nodes.clear();
+    freeSlots.clear();
+    if (queued > 0) {
+        for (Entry& entry : table) {
+            entry.slot = -1;
+        }
+    }
+    queued = 0;
+    root = -1;
+}
+
+//==============================================================
+// findEntry
+// INPUTS: NodeID
+// OUTPUTS: Position of its entry in the table, -1 if not queued
+// Linear probing from the item's home position up to the first
+// empty entry
+//==============================================================
+template <class T>
+int PairingHeap<T>::findEntry(const T& item) const {
+    if (queued == 0) {
+        return -1;
+    }
+    size_t mask = table.size() - 1;
+    for (size_t i = home(item); table[i].slot != -1; i = (i + 1) & mask) {
+        if (table[i].item == item) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+//==============================================================
+// addEntry
+// INPUTS: NodeID that is not queued, its slot in the pool
+// OUTPUTS: NONE
+// Doubles the table first if it would become more than half full
+//==============================================================
+template <class T>
+void PairingHeap<T>::addEntry(const T& item, int slot) {
+    if (2 * (static_cast<size_t>(queued) + 1) > table.size()) {
+        growTable();
+    }
+    size_t mask = table.size() - 1;
+    size_t i = home(item);
+    while (table[i].slot != -1) {
+        i = (i + 1) & mask;
+    }
+    table[i] = {item, slot};
+    queued++;
+}
+
+//==============================================================
+// removeEntry
+// INPUTS: Position of an entry in the table
+// OUTPUTS: NONE
+// Empties the entry, then moves back any later entry of the same
+// probe run that could no longer be found past the gap, so no
+// deleted markers are left behind
+//==============================================================
+template <class T>
+void PairingHeap<T>::removeEntry(int at) {
+    size_t mask = table.size() - 1;
+    size_t gap = at;
+    for (size_t i = (gap + 1) & mask; table[i].slot != -1; i = (i + 1) & mask) {
+        // an entry stays if its home lies cyclically in (gap, i]
+        size_t h = home(table[i].item);
+        bool stays = gap < i ? (gap < h && h <= i) : (gap < h || h <= i);
+        if (!stays) {
+            table[gap] = table[i];
+            gap = i;
+        }
+    }
+    table[gap].slot = -1;
+    queued--;
+}
+
+//==============================================================
+// growTable
+// INPUTS: NONE
+// OUTPUTS: NONE
+// Doubles the table (16 entries to start) and puts every queued
+// item back in
+//==============================================================
+template <class T>
+void PairingHeap<T>::growTable() {
+    vector<Entry> old;
+    old.swap(table);
+    tableBits = tableBits == 0 ? 4 : tableBits + 1;
+    table.assign(static_cast<size_t>(1) << tableBits, Entry{T(), -1});
+    queued = 0;
+    for (const Entry& entry : old) {
+        if (entry.slot != -1) {
+            addEntry(entry.item, entry.slot);
+        }
+    }
+}
+
+//==============================================================
+// Insert
+// INPUTS: NodeID and its weight
+// OUTPUTS: NONE
+// Inserts a node by melding a one-node heap with the root
+//==============================================================
+template <class T>
+void PairingHeap<T>::insert(const T& nodeId, double priority) {
+    if (findEntry(nodeId) != -1) {
+        throw runtime_error("Node already exists in priority queue");
+    }
+
+    int slot = newNode(nodeId, priority);
+    addEntry(nodeId, slot);
+    root = meld(root, slot);
+}
+
+//==============================================================
+// mergePairs
+// INPUTS: First node of a sibling list
+// OUTPUTS: Root of the merged heap
+// Standard two-pass pairing: meld siblings in pairs left to
+// right, then meld the results right to left
+//==============================================================
+template <class T>
+int PairingHeap<T>::mergePairs(int first) {
+    pairs.clear();
+    while (first != -1) {
+        int a = first;
+        int b = nodes[a].sibling;
+        first = b == -1 ? -1 : nodes[b].sibling;
+        nodes[a].sibling = nodes[a].prev = -1;
+        if (b != -1) {
+            nodes[b].sibling = nodes[b].prev = -1;
+        }
+        pairs.push_back(meld(a, b));
+    }
+
+    int merged = -1;
+    for (int i = static_cast<int>(pairs.size()) - 1; i >= 0; i--) {
+        merged = meld(pairs[i], merged);
+    }
+    return merged;
+}
+
+//==============================================================
+// Extract Min
+// INPUTS: NONE
+// OUTPUTS: Pair with NodeID and weight
+// Takes the root out of the heap and returns it
+//==============================================================
+template <class T>
+pair<T, double> PairingHeap<T>::extractMin() {
+    if (isEmpty()) {
+        throw runtime_error("Priority queue is empty");
+    }
+
+    int oldRoot = root;
+    pair<T, double> minElement = make_pair(nodes[oldRoot].item, nodes[oldRoot].priority);
+    root = mergePairs(nodes[oldRoot].child);
+    removeEntry(findEntry(minElement.first));
+    freeSlots.push_back(oldRoot);
+    return minElement;
+}
+
+//==============================================================
+// Peek Min
+// INPUTS: NONE
+// OUTPUTS: Pair with NodeID and weight
+// Returns the min value without taking it out of the heap
+//==============================================================
+template <class T>
+pair<T, double> PairingHeap<T>::peekMin() const {
+    if (isEmpty()) {
+        throw runtime_error("Priority queue is empty");
+    }
+    return make_pair(nodes[root].item, nodes[root].priority);
+}
+
+//==============================================================
+// Decrease Key
+// INPUTS: NodeID to change, its new weight
+// OUTPUTS: NONE
+// Lowers the weight of a queued node, cutting its subtree out
+// and melding it with the root; a higher weight is ignored
+//==============================================================
+template <class T>
+void PairingHeap<T>::decreaseKey(const T& nodeId, double newPriority) {
+    int at = findEntry(nodeId);
+    if (at == -1) {
+        throw runtime_error("Node not found in priority queue");
+    }
+
+    int slot = table[at].slot;
+    if (newPriority >= nodes[slot].priority) {
+        return;
+    }
+    nodes[slot].priority = newPriority;
+    if (slot == root) {
+        return;
+    }
+
+    // unlink the subtree from its parent or left sibling
+    int prev = nodes[slot].prev;
+    if (nodes[prev].child == slot) {
+        nodes[prev].child = nodes[slot].sibling;
+    }
+    else {
+        nodes[prev].sibling = nodes[slot].sibling;
+    }
+    if (nodes[slot].sibling != -1) {
+        nodes[nodes[slot].sibling].prev = prev;
+    }
+    nodes[slot].sibling = nodes[slot].prev = -1;
+    root = meld(root, slot);
+}
+
+//==============================================================
+// PrintMinHeap
+// INPUTS: NONE
+// OUTPUTS: NONE
+// Prints out each queued node and its weight in index order
+//==============================================================
+template <class T>
+void PairingHeap<T>::printMinHeap() {
+    cout << "Priority Queue (Pairing Heap):" << endl;
+    cout << "-----------------------------------" << endl;
+
+    for (const Entry& entry : table) {
+        if (entry.slot != -1) {
+            cout << entry.slot << ": "
+                 << entry.item << ", "
+                 << nodes[entry.slot].priority << endl;
+        }
+    }
+}
+
+template class PairingHeap<long>;
+template class PairingHeap<long long>;
+template class PairingHeap<int>;
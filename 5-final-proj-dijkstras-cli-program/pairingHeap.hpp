@@ -0,0 +1,108 @@
+//=========================================================
+// PairingHeap.hpp
+// Andrew McCutchan, Namu Kim
+// Header file containing all function delcarations for
+// PairingHeap class. A min pairing heap with the same
+// interface as PriorityQueue; decreaseKey cuts the node's
+// subtree and melds it with the root in O(1) amortized time.
+// 12/18/2024
+//=========================================================
+
+#ifndef PAIRING_HEAP_HPP
+#define PAIRING_HEAP_HPP
+
+#include <iostream>
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+using namespace std;
+
+template <typename T>
+class PairingHeap {
+    private:
+        // children of a node form a doubly linked sibling list;
+        // prev is the parent for the first child
+        struct Node {
+            T       item;
+            double  priority;
+            int     child;
+            int     sibling;
+            int     prev;
+        };
+
+        // one entry of the item -> slot index; slot -1 marks it empty
+        struct Entry {
+            T       item;
+            int     slot;
+        };
+
+        // nodes live in one pool and are linked by index. Freed
+        // slots are reused, and the index is an open addressing
+        // table that clear() keeps, so after warm-up inserts never
+        // allocate.
+        vector<Node>        nodes;
+        vector<int>         freeSlots;
+        vector<int>         pairs;              // scratch list for extractMin
+        vector<Entry>       table;              // power of two size, at most half full
+        int                 tableBits;
+        int                 queued;
+        int                 root;
+
+        // Fibonacci hashing: the top bits of item * 2^64 / phi
+        size_t home(const T& item) const {
+            return (static_cast<uint64_t>(item) * 0x9E3779B97F4A7C15ull) >> (64 - tableBits);
+        }
+
+        int newNode(const T& item, double priority) {
+            int slot;
+            if (freeSlots.empty()) {
+                slot = nodes.size();
+                nodes.push_back(Node());
+            }
+            else {
+                slot = freeSlots.back();
+                freeSlots.pop_back();
+            }
+            nodes[slot] = {item, priority, -1, -1, -1};
+            return slot;
+        }
+
+        // links two roots, the larger becoming the first child of the smaller
+        int meld(int a, int b) {
+            if (a == -1) return b;
+            if (b == -1) return a;
+            if (nodes[b].priority < nodes[a].priority) {
+                swap(a, b);
+            }
+            nodes[b].prev = a;
+            nodes[b].sibling = nodes[a].child;
+            if (nodes[a].child != -1) {
+                nodes[nodes[a].child].prev = b;
+            }
+            nodes[a].child = b;
+            nodes[a].sibling = -1;
+            nodes[a].prev = -1;
+            return a;
+        }
+
+        int     mergePairs(int first);
+        int     findEntry(const T& item) const;
+        void    addEntry(const T& item, int slot);
+        void    removeEntry(int at);
+        void    growTable();
+
+    public:
+                            PairingHeap();
+        void                insert(const T& nodeId, double priority);
+        pair<T, double>     extractMin();
+        pair<T, double>     peekMin() const;
+        void                decreaseKey(const T& nodeId, double newPriority);
+        void                printMinHeap();
+        void                clear();
+
+        bool                isEmpty() const { return root == -1; }
+        bool                contains(const T& nodeId) const { return findEntry(nodeId) != -1; }
+        int                 size() const { return queued; }
+};
+
+#endif
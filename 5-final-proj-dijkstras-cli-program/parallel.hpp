@@ -0,0 +1,184 @@
+//=========================================================
+// Parallel.hpp
+// Andrew McCutchan, Namu Kim
+// Header file containing runParallel, a small helper that
+// runs one task per thread and collects their exceptions,
+// Barrier, which holds those threads together between phases,
+// and WorkerPool, which keeps threads alive between tasks.
+// 12/18/2024
+//=========================================================
+
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <vector>
+#include <thread>
+#include <exception>
+#include <algorithm>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+using namespace std;
+
+//==============================================================
+// threadCount
+// INPUTS: Requested number of threads, 0 for one per core
+// OUTPUTS: Number of threads to use, at least 1
+//==============================================================
+inline int threadCount(int requested) {
+    return requested > 0 ? requested : max(1u, thread::hardware_concurrency());
+}
+
+//==============================================================
+// runParallel
+// INPUTS: Number of threads and a task taking the thread index
+// OUTPUTS: NONE
+// Runs task(0) .. task(threads - 1) on their own threads, waits
+// for all of them and rethrows the first exception, if any
+//==============================================================
+template <typename F>
+void runParallel(int threads, F task) {
+    vector<thread> workers;
+    vector<exception_ptr> errors(threads);
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            try {
+                task(t);
+            } catch (...) {
+                errors[t] = current_exception();
+            }
+        });
+    }
+    for (thread& worker : workers) {
+        worker.join();
+    }
+    for (exception_ptr& error : errors) {
+        if (error) {
+            rethrow_exception(error);
+        }
+    }
+}
+
+//==============================================================
+// Barrier
+// Threads calling wait() block until all of them have called it,
+// then all go on. It can be reused for any number of rounds, and
+// everything written before wait() is visible after it.
+//==============================================================
+class Barrier {
+    private:
+        mutex               lock;
+        condition_variable  released;
+        int                 threads;
+        int                 waiting = 0;
+        unsigned long       round = 0;
+
+    public:
+        Barrier(int threads) : threads(threads) {}
+
+        void wait() {
+            unique_lock<mutex> guard(lock);
+            unsigned long current = round;
+            if (++waiting == threads) {
+                waiting = 0;
+                round++;
+                released.notify_all();
+            }
+            else {
+                released.wait(guard, [&]() { return round != current; });
+            }
+        }
+};
+
+//==============================================================
+// WorkerPool
+// Starts threads - 1 threads once and keeps them waiting, so a
+// task that is run many times, such as one round of a search,
+// doesn't pay for starting threads each time. run(task) calls
+// task(0) .. task(threads - 1) like runParallel, with task(0) on
+// the calling thread, and returns once all of them are done.
+//==============================================================
+class WorkerPool {
+    private:
+        mutex                   lock;
+        condition_variable      started;
+        condition_variable      finished;
+        vector<thread>          workers;
+        vector<exception_ptr>   errors;
+        function<void(int)>     task;
+        unsigned long           round = 0;
+        int                     running = 0;
+        bool                    stopping = false;
+
+        void work(int t) {
+            unsigned long seen = 0;
+            unique_lock<mutex> guard(lock);
+            while (true) {
+                started.wait(guard, [&]() { return stopping || round != seen; });
+                if (stopping) {
+                    return;
+                }
+                seen = round;
+                guard.unlock();
+                try {
+                    task(t);
+                } catch (...) {
+                    errors[t] = current_exception();
+                }
+                guard.lock();
+                if (--running == 0) {
+                    finished.notify_one();
+                }
+            }
+        }
+
+    public:
+        WorkerPool(int threads) : errors(max(threads, 1)) {
+            for (int t = 1; t < threads; t++) {
+                workers.emplace_back(&WorkerPool::work, this, t);
+            }
+        }
+
+        ~WorkerPool() {
+            {
+                lock_guard<mutex> guard(lock);
+                stopping = true;
+            }
+            started.notify_all();
+            for (thread& worker : workers) {
+                worker.join();
+            }
+        }
+
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        int size() const { return errors.size(); }
+
+        void run(function<void(int)> job) {
+            {
+                lock_guard<mutex> guard(lock);
+                task = move(job);
+                fill(errors.begin(), errors.end(), nullptr);
+                running = workers.size();
+                round++;
+            }
+            started.notify_all();
+            try {
+                task(0);
+            } catch (...) {
+                errors[0] = current_exception();
+            }
+            {
+                unique_lock<mutex> guard(lock);
+                finished.wait(guard, [&]() { return running == 0; });
+            }
+            for (exception_ptr& error : errors) {
+                if (error) {
+                    rethrow_exception(error);
+                }
+            }
+        }
+};
+
+#endif
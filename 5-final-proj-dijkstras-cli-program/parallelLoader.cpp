@@ -0,0 +1,268 @@
+//=========================================================
+// ParallelLoader.cpp
+// Andrew McCutchan, Namu Kim
+// Implementaiton file for ParallelLoader class
+// 12/18/2024
+//=========================================================
+
+#include "parallelLoader.hpp"
+
+//==============================================================
+// Constructor
+// INPUTS: File name and number of threads (0 for one per core)
+// OUTPUTS: NONE
+// Maps the file and parses it: the header and vertex lines on
+// this thread, the edge lines in parallel
+//==============================================================
+template <class T>
+ParallelLoader<T>::ParallelLoader(const string& filename, int threads) : parser(filename) {
+    this->threads = threadCount(threads);
+    readVertices();
+    readEdges();
+}
+
+//==============================================================
+// readVertices
+// INPUTS: NONE
+// OUTPUTS: NONE
+// Reads the "n m" header and the n vertex lines
+//==============================================================
+template <class T>
+void ParallelLoader<T>::readVertices() {
+    if (!parser.skipBlankLines()) {
+        throw parse_exception(parser.line(), "missing vertex and edge counts");
+    }
+    vertexLines = parser.readInteger<int>("vertex count");
+    edgeLines = parser.readInteger<int>("edge count");
+    parser.endLine();
+
+    vertexIds.reserve(vertexLines);
+    vertexCoords.reserve(2 * vertexLines);
+    for (int i = 0; i < vertexLines; i++) {
+        if (!parser.skipBlankLines()) {
+            throw parse_exception(parser.line(), "expected " + to_string(vertexLines) + " vertices, found " + to_string(i));
+        }
+        vertexIds.push_back(parser.readInteger<T>("node ID"));
+        vertexCoords.push_back(parser.readDouble("x coordinate"));
+        vertexCoords.push_back(parser.readDouble("y coordinate"));
+        parser.endLine();
+    }
+}
+
+//==============================================================
+// readEdges
+// INPUTS: NONE
+// OUTPUTS: NONE
+// Cuts the rest of the file into one chunk per thread at line
+// boundaries and parses the chunks in parallel. Errors are only
+// reported if the sequential loader would have reached them, i.e.
+// if they come before the m-th edge line, so both loaders accept
+// and reject exactly the same files.
+//==============================================================
+template <class T>
+void ParallelLoader<T>::readEdges() {
+    const char* begin = parser.position();
+    const char* end = parser.inputEnd();
+    vector<const char*> bounds(threads + 1);
+    bounds[0] = begin;
+    bounds[threads] = end;
+    for (int t = 1; t < threads; t++) {
+        const char* cut = max(bounds[t - 1], begin + (end - begin) / threads * t);
+        cut = find(cut, end, '\n');
+        bounds[t] = cut == end ? end : cut + 1;
+    }
+
+    // line numbers of each chunk's first line, for error messages
+    vector<int> firstLines(threads + 1);
+    firstLines[0] = parser.line();
+    runParallel(threads, [&](int t) {
+        firstLines[t + 1] = count(bounds[t], bounds[t + 1], '\n');
+    });
+    for (int t = 0; t < threads; t++) {
+        firstLines[t + 1] += firstLines[t];
+    }
+
+    chunks.assign(threads, vector<Edge>());
+    vector<exception_ptr> errors(threads);
+    runParallel(threads, [&](int t) {
+        GraphParser chunk(bounds[t], bounds[t + 1], firstLines[t]);
+        vector<Edge>& edges = chunks[t];
+        edges.reserve((bounds[t + 1] - bounds[t]) / 24);
+        try {
+            while (chunk.skipBlankLines()) {
+                Edge edge;
+                edge.source = chunk.readInteger<T>("edge start");
+                edge.target = chunk.readInteger<T>("edge end");
+                edge.weight = chunk.readDouble("edge weight");
+                chunk.readRest();   // street name, not used yet
+                chunk.endLine();
+                edges.push_back(edge);
+            }
+        } catch (const parse_exception&) {
+            errors[t] = current_exception();
+        }
+    });
+
+    // keep the first m edges in file order, like the sequential loader
+    long long found = 0;
+    for (int t = 0; t < threads; t++) {
+        long long keep = min<long long>(chunks[t].size(), max(0LL, edgeLines - found));
+        if (errors[t] && found + static_cast<long long>(chunks[t].size()) < edgeLines) {
+            rethrow_exception(errors[t]);
+        }
+        found += chunks[t].size();
+        chunks[t].resize(keep);
+        if (errors[t]) {
+            for (int rest = t + 1; rest < threads; rest++) {
+                chunks[rest].clear();
+            }
+            break;
+        }
+    }
+    if (found < edgeLines) {
+        throw parse_exception(firstLines[threads], "expected " + to_string(edgeLines) + " edges, found " + to_string(found));
+    }
+}
+
+//==============================================================
+// build
+// INPUTS: NONE
+// OUTPUTS: CSR graph of the file
+// Maps node IDs to dense indices, then buckets every edge by its
+// source with a counting sort: each thread counts the sources in
+// its chunk, a prefix sum over (source, thread) gives every thread
+// its own slots, and the threads scatter their edges in parallel.
+// Within a node the edges are sorted by target and repeated edges
+// keep their last weight in the file, exactly as addEdge would.
+//==============================================================
+template <class T>
+CSRGraph<T> ParallelLoader<T>::build() {
+    // dense indices: sorted vertex IDs plus any edge endpoint that
+    // never had a vertex line
+    vector<T> idList(vertexIds);
+    sort(idList.begin(), idList.end());
+    idList.erase(unique(idList.begin(), idList.end()), idList.end());
+
+    vector<vector<T> > missing(threads);
+    runParallel(threads, [&](int t) {
+        for (const Edge& edge : chunks[t]) {
+            for (T id : {edge.source, edge.target}) {
+                if (!binary_search(idList.begin(), idList.end(), id)) {
+                    missing[t].push_back(id);
+                }
+            }
+        }
+    });
+    size_t vertexCount = idList.size();
+    for (vector<T>& extra : missing) {
+        idList.insert(idList.end(), extra.begin(), extra.end());
+    }
+    if (idList.size() > vertexCount) {
+        sort(idList.begin() + vertexCount, idList.end());
+        inplace_merge(idList.begin(), idList.begin() + vertexCount, idList.end());
+        idList.erase(unique(idList.begin(), idList.end()), idList.end());
+    }
+    int n = idList.size();
+    auto denseId = [&](T id) {
+        return static_cast<int>(lower_bound(idList.begin(), idList.end(), id) - idList.begin());
+    };
+
+    // later vertex lines for the same ID overwrite earlier ones
+    vector<double> coordList(2 * n, numeric_limits<double>::quiet_NaN());
+    for (size_t i = 0; i < vertexIds.size(); i++) {
+        int u = denseId(vertexIds[i]);
+        coordList[2 * u] = vertexCoords[2 * i];
+        coordList[2 * u + 1] = vertexCoords[2 * i + 1];
+    }
+
+    // count the sources of each chunk
+    vector<vector<int> > sources(threads), heads(threads), slots(threads);
+    runParallel(threads, [&](int t) {
+        sources[t].resize(chunks[t].size());
+        heads[t].resize(chunks[t].size());
+        slots[t].assign(n, 0);
+        for (size_t i = 0; i < chunks[t].size(); i++) {
+            sources[t][i] = denseId(chunks[t][i].source);
+            heads[t][i] = denseId(chunks[t][i].target);
+            slots[t][sources[t][i]]++;
+        }
+    });
+
+    // prefix sum over (source, thread) so each thread's edges land
+    // after those of earlier chunks, keeping file order per source
+    vector<int> bucketOffsets(n + 1, 0);
+    int position = 0;
+    for (int u = 0; u < n; u++) {
+        bucketOffsets[u] = position;
+        for (int t = 0; t < threads; t++) {
+            int count = slots[t][u];
+            slots[t][u] = position;
+            position += count;
+        }
+    }
+    bucketOffsets[n] = position;
+
+    vector<int> bucketTargets(position);
+    vector<double> bucketWeights(position);
+    runParallel(threads, [&](int t) {
+        for (size_t i = 0; i < chunks[t].size(); i++) {
+            int slot = slots[t][sources[t][i]]++;
+            bucketTargets[slot] = heads[t][i];
+            bucketWeights[slot] = chunks[t][i].weight;
+        }
+        vector<Edge>().swap(chunks[t]);
+    });
+
+    // sort each node's edges by target, dropping all but the last of
+    // repeated edges, and compact them to the front of the bucket
+    vector<int> degree(n);
+    runParallel(threads, [&](int t) {
+        vector<pair<int, int> > order;
+        vector<double> weightCopy;
+        for (int u = static_cast<long long>(n) * t / threads; u < static_cast<long long>(n) * (t + 1) / threads; u++) {
+            int first = bucketOffsets[u], last = bucketOffsets[u + 1];
+            order.clear();
+            weightCopy.assign(bucketWeights.begin() + first, bucketWeights.begin() + last);
+            for (int e = first; e < last; e++) {
+                order.push_back(make_pair(bucketTargets[e], e - first));
+            }
+            sort(order.begin(), order.end());
+
+            int kept = 0;
+            for (size_t i = 0; i < order.size(); i++) {
+                if (i + 1 < order.size() && order[i + 1].first == order[i].first) {
+                    continue;
+                }
+                bucketTargets[first + kept] = order[i].first;
+                bucketWeights[first + kept] = weightCopy[order[i].second];
+                kept++;
+            }
+            degree[u] = kept;
+        }
+    });
+
+    vector<int> offsetList(n + 1, 0);
+    for (int u = 0; u < n; u++) {
+        offsetList[u + 1] = offsetList[u] + degree[u];
+    }
+    if (offsetList[n] == position) {
+        return CSRGraph<T>(move(idList), move(coordList), move(offsetList), move(bucketTargets), move(bucketWeights));
+    }
+
+    vector<int> targetList(offsetList[n]);
+    vector<double> weightList(offsetList[n]);
+    runParallel(threads, [&](int t) {
+        for (int u = static_cast<long long>(n) * t / threads; u < static_cast<long long>(n) * (t + 1) / threads; u++) {
+            copy(bucketTargets.begin() + bucketOffsets[u], bucketTargets.begin() + bucketOffsets[u] + degree[u],
+                 targetList.begin() + offsetList[u]);
+            copy(bucketWeights.begin() + bucketOffsets[u], bucketWeights.begin() + bucketOffsets[u] + degree[u],
+                 weightList.begin() + offsetList[u]);
+        }
+    });
+    return CSRGraph<T>(move(idList), move(coordList), move(offsetList), move(targetList), move(weightList));
+}
+
+// class instantiations
+template class ParallelLoader<long>;
+template class ParallelLoader<long long>;
+template class ParallelLoader<int>;
@@ -0,0 +1,52 @@
+//=========================================================
+// ParallelLoader.hpp
+// Andrew McCutchan, Namu Kim
+// Header file containing all function delcarations for
+// ParallelLoader class. A ParallelLoader reads a text graph
+// file by splitting its edge section into chunks parsed on
+// separate threads, then builds the CSR arrays directly with
+// a parallel counting sort by source node.
+// 12/18/2024
+//=========================================================
+
+#ifndef PARALLEL_LOADER_HPP
+#define PARALLEL_LOADER_HPP
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <limits>
+#include "parallel.hpp"
+#include "graphParser.hpp"
+#include "csrGraph.hpp"
+using namespace std;
+
+template <typename T>
+class ParallelLoader {
+    private:
+        struct Edge {
+            T       source;
+            T       target;
+            double  weight;
+        };
+
+        GraphParser             parser;         // owns the mapped file the chunks point into
+        int                     threads;
+        int                     vertexLines;    // n from the header
+        int                     edgeLines;      // m from the header
+        vector<T>               vertexIds;      // in file order
+        vector<double>          vertexCoords;   // x and y of each vertex line, interleaved
+        vector<vector<Edge> >   chunks;         // edges parsed by each thread, in file order
+
+        void    readVertices();
+        void    readEdges();
+
+    public:
+                        ParallelLoader(const string& filename, int threads);
+        CSRGraph<T>     build();
+
+        // getter functions
+        int             numVertexLines() const { return vertexLines; }
+};
+
+#endif
@@ -13,8 +13,19 @@
 // OUTPUTS: NONE
 // Createa empty prioirty queue object
 //==============================================================
-template <class T>
-PriorityQueue<T>::PriorityQueue() {}
+template <class T, int Arity>
+PriorityQueue<T, Arity>::PriorityQueue() {}
+
+//==============================================================
+// Bulk Constructor
+// INPUTS: List of (node, weight) pairs
+// OUTPUTS: NONE
+// Builds a priority queue holding every pair at once (see assign)
+//==============================================================
+template <class T, int Arity>
+PriorityQueue<T, Arity>::PriorityQueue(vector<pair<T, double> > items) {
+    assign(move(items));
+}
 
 //==============================================================
 // Copy Constructor
@@ -22,8 +33,8 @@ PriorityQueue<T>::PriorityQueue() {}
 // OUTPUTS: NONE
 // Copies data from existing priority queue object
 //==============================================================
-template <class T>
-PriorityQueue<T>::PriorityQueue(const PriorityQueue& other) {
+template <class T, int Arity>
+PriorityQueue<T, Arity>::PriorityQueue(const PriorityQueue& other) {
     minHeap = other.minHeap;
     position = other.position;
 }
@@ -34,8 +45,8 @@ PriorityQueue<T>::PriorityQueue(const PriorityQueue& other) {
 // OUTPUTS: NONE
 // Frees up memory
 //==============================================================
-template <class T>
-PriorityQueue<T>::~PriorityQueue() {
+template <class T, int Arity>
+PriorityQueue<T, Arity>::~PriorityQueue() {
     minHeap.clear();
     position.clear();
 }
@@ -45,8 +56,8 @@ PriorityQueue<T>::~PriorityQueue() {
 // INPUTS: Other PQ object
 // OUTPUTS: New PQ object contained data from existing PQ
 //==============================================================
-template <class T>
-PriorityQueue<T>& PriorityQueue<T>::operator=(const PriorityQueue<T>& other) {
+template <class T, int Arity>
+PriorityQueue<T, Arity>& PriorityQueue<T, Arity>::operator=(const PriorityQueue<T, Arity>& other) {
     if (this != &other) {
         minHeap = other.minHeap;
         position = other.position;
@@ -54,8 +65,8 @@ PriorityQueue<T>& PriorityQueue<T>::operator=(const PriorityQueue<T>& other) {
     return *this;
 }
 
-template <class T>
-pair<T, double> PriorityQueue<T>::operator[](const T& index) const {
+template <class T, int Arity>
+pair<T, double> PriorityQueue<T, Arity>::operator[](const T& index) const {
     if (index < 0 || index >= static_cast<int>(minHeap.size())) {
         throw std::out_of_range("Index out of range");
     }
@@ -68,8 +79,8 @@ pair<T, double> PriorityQueue<T>::operator[](const T& index) const {
 // OUTPUTS: NONE
 // Inserts a node with its weight from the start ID
 //==============================================================
-template <class T>
-void PriorityQueue<T>::insert(const T& nodeId, double priority) {
+template <class T, int Arity>
+void PriorityQueue<T, Arity>::insert(const T& nodeId, double priority) {
     if (position.count(nodeId) > 0) {
         throw runtime_error("Node already exists in priority queue");
     }
@@ -80,14 +91,42 @@ void PriorityQueue<T>::insert(const T& nodeId, double priority) {
     heapifyUp(minHeap.size() - 1);
 }
 
+//==============================================================
+// Assign
+// INPUTS: List of (node, weight) pairs
+// OUTPUTS: NONE
+// Replaces the contents of the queue with the pairs. The heap is
+// built bottom-up in O(n) and the position table is sized once,
+// instead of sifting up and hashing each pair on its own. Throws
+// and leaves the queue unchanged if a node appears twice.
+//==============================================================
+template <class T, int Arity>
+void PriorityQueue<T, Arity>::assign(vector<pair<T, double> > items) {
+    int size = items.size();
+    for (int i = (size - 2) / Arity; i >= 0 && size > 1; i--) {
+        siftDown(items, i);
+    }
+
+    unordered_map<T, int> newPosition;
+    newPosition.reserve(size);
+    for (int i = 0; i < size; i++) {
+        if (!newPosition.emplace(items[i].first, i).second) {
+            throw runtime_error("Node already exists in priority queue");
+        }
+    }
+
+    minHeap.swap(items);
+    position.swap(newPosition);
+}
+
 //==============================================================
 // Extract Min
 // INPUTS: NONE
 // OUTPUTS: Pair with node and weight
 // Takes the min value out of the priority queue and returns it 
 //==============================================================
-template <class T>
-pair<T, double> PriorityQueue<T>::extractMin() {
+template <class T, int Arity>
+pair<T, double> PriorityQueue<T, Arity>::extractMin() {
     if (isEmpty()) {
         throw runtime_error("Priority queue is empty");
     }
@@ -109,14 +148,28 @@ pair<T, double> PriorityQueue<T>::extractMin() {
     return minElement;
 }
 
+//==============================================================
+// Peek Min
+// INPUTS: NONE
+// OUTPUTS: Pair with node and weight
+// Returns the min value without taking it out of the queue
+//==============================================================
+template <class T, int Arity>
+pair<T, double> PriorityQueue<T, Arity>::peekMin() const {
+    if (isEmpty()) {
+        throw runtime_error("Priority queue is empty");
+    }
+    return minHeap[0];
+}
+
 //==============================================================
 // Decrease Key 
 // INPUTS: Node ID to change, its new priority
 // OUTPUTS: NONE
 // Enters an existing node and a new values to make its priority
 //==============================================================
-template <class T>
-void PriorityQueue<T>::decreaseKey(const T& nodeId, double newPriority) {
+template <class T, int Arity>
+void PriorityQueue<T, Arity>::decreaseKey(const T& nodeId, double newPriority) {
     if (position.count(nodeId) == 0) {
         throw runtime_error("Node not found in priority queue");
     }
@@ -138,8 +191,8 @@ void PriorityQueue<T>::decreaseKey(const T& nodeId, double newPriority) {
 // OUTPUTS: NONE
 // Prints out the min PQ
 //==============================================================
-template <class T>
-void PriorityQueue<T>::printMinHeap() {
+template <class T, int Arity>
+void PriorityQueue<T, Arity>::printMinHeap() {
     cout << "Priority Queue (Min-Heap):" << endl;
     cout << "-----------------------------------" << endl;
 
@@ -152,4 +205,10 @@ void PriorityQueue<T>::printMinHeap() {
 
 template class PriorityQueue<long>;
 template class PriorityQueue<long long>;
-template class PriorityQueue<int>;
\ No newline at end of file
+template class PriorityQueue<int>;
+template class PriorityQueue<long, 4>;
+template class PriorityQueue<long long, 4>;
+template class PriorityQueue<int, 4>;
+template class PriorityQueue<long, 8>;
+template class PriorityQueue<long long, 8>;
+template class PriorityQueue<int, 8>;
\ No newline at end of file
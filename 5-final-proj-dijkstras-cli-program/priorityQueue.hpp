@@ -2,7 +2,9 @@
 // PriorityQueue.hpp
 // Andrew McCutchan, Namu Kim
 // Header file containing all function delcarations for
-// PriorityQueue class.
+// PriorityQueue class. Arity is the number of children of each
+// heap node: wider heaps are shallower, which suits workloads
+// with many decreaseKey calls.
 // 12/18/2024
 //=========================================================
 
@@ -12,12 +14,16 @@
 #include <iostream>
 #include <vector>
 #include <unordered_map>
+#include <utility>
 #include <stdexcept>
 #include <iomanip>
+#include <algorithm>
 using namespace std;
 
-template <typename T>
+template <typename T, int Arity = 2>
 class PriorityQueue {
+    static_assert(Arity >= 2, "a heap needs at least two children per node");
+
     private:
         vector<pair<T, double> > minHeap;  //T is the node and double is the weight
         unordered_map<T, int> position;
@@ -25,7 +31,7 @@ class PriorityQueue {
         // helpers for maintaining heap property when adding or deleting
         void heapifyUp(int index) {
             while (index > 0) {
-                int parentIndex = (index - 1) / 2;
+                int parentIndex = (index - 1) / Arity;
                 
                 if (minHeap[parentIndex].second > minHeap[index].second) {
                     swap(minHeap[parentIndex], minHeap[index]);
@@ -45,17 +51,13 @@ class PriorityQueue {
             int size = minHeap.size();
             while (true) {
                 int smallest = index;
-                int leftChild = 2 * index + 1;
-                int rightChild = 2 * index + 2;
-
-                if (leftChild < size && 
-                    minHeap[leftChild].second < minHeap[smallest].second) {
-                    smallest = leftChild;
-                }
+                int firstChild = Arity * index + 1;
+                int lastChild = min(firstChild + Arity, size);
 
-                if (rightChild < size && 
-                    minHeap[rightChild].second < minHeap[smallest].second) {
-                    smallest = rightChild;
+                for (int child = firstChild; child < lastChild; child++) {
+                    if (minHeap[child].second < minHeap[smallest].second) {
+                        smallest = child;
+                    }
                 }
 
                 if (smallest != index) {
@@ -72,18 +74,50 @@ class PriorityQueue {
             }
         }
 
+        // heapifyDown without position updates, for building a heap
+        // whose positions are filled in afterwards
+        static void siftDown(vector<pair<T, double> >& heap, int index) {
+            int size = heap.size();
+            pair<T, double> moving = heap[index];
+            while (true) {
+                int smallest = -1;
+                double smallestPriority = moving.second;
+                int firstChild = Arity * index + 1;
+                int lastChild = min(firstChild + Arity, size);
+
+                for (int child = firstChild; child < lastChild; child++) {
+                    if (heap[child].second < smallestPriority) {
+                        smallest = child;
+                        smallestPriority = heap[child].second;
+                    }
+                }
+
+                if (smallest == -1) {
+                    break;
+                }
+                heap[index] = heap[smallest];
+                index = smallest;
+            }
+            heap[index] = moving;
+        }
+
     public:
                             PriorityQueue();
+                            PriorityQueue(vector<pair<T, double> > items);
                             PriorityQueue(const PriorityQueue& other);
                             ~PriorityQueue();
         pair<T, double>     operator[](const T& index) const;
         PriorityQueue&      operator=(const PriorityQueue &other);
         void                insert(const T& nodeId, double priority);
+        void                assign(vector<pair<T, double> > items);
         pair<T, double>     extractMin();
+        pair<T, double>     peekMin() const;
         void                decreaseKey(const T& nodeId, double newPriority);
         void                printMinHeap();
+        void                clear() { minHeap.clear(); position.clear(); }
         
         bool                isEmpty() const { return minHeap.empty(); }
+        bool                contains(const T& nodeId) const { return position.count(nodeId) > 0; }
         int                 size() const { return minHeap.size(); }
 };
 
@@ -0,0 +1,209 @@
+//=========================================================
+// RadixHeap.cpp
+// Andrew McCutchan, Namu Kim
+// Implementaiton file for RadixHeap class
+// 12/18/2024
+//=========================================================
+
+#include "radixHeap.hpp"
+
+//==============================================================
+// Default Constructor
+// INPUTS: NONE
+// OUTPUTS: NONE
+// Creates an empty heap with room for no handles; it grows on
+// insert or resize
+//==============================================================
+RadixHeap::RadixHeap() {
+    last = 0;
+    count = 0;
+}
+
+//==============================================================
+// Constructor
+// INPUTS: Number of handles
+// OUTPUTS: NONE
+// Creates an empty heap for handles 0..n-1
+//==============================================================
+RadixHeap::RadixHeap(int n) {
+    last = 0;
+    count = 0;
+    resize(n);
+}
+
+//==============================================================
+// resize
+// INPUTS: Number of handles
+// OUTPUTS: NONE
+// Empties the heap and makes room for handles 0..n-1
+//==============================================================
+void RadixHeap::resize(int n) {
+    clear();
+    if (static_cast<int>(queued.size()) != n) {
+        keys.assign(n, 0);
+        priorities.assign(n, 0);
+        queued.assign(n, 0);
+    }
+}
+
+//==============================================================
+// clear
+// INPUTS: NONE
+// OUTPUTS: NONE
+// Empties the heap in time proportional to its entries and starts
+// accepting any non-negative priority again
+//==============================================================
+void RadixHeap::clear() {
+    for (vector<pair<uint64_t, int> >& bucket : buckets) {
+        for (const pair<uint64_t, int>& entry : bucket) {
+            queued[entry.second] = 0;
+        }
+        bucket.clear();
+    }
+    last = 0;
+    count = 0;
+}
+
+//==============================================================
+// checkedKey
+// INPUTS: Priority
+// OUTPUTS: Key of the priority
+// Throws if the priority is negative, NaN, or below the last
+// extracted one, since the heap only moves forward
+//==============================================================
+uint64_t RadixHeap::checkedKey(double priority) const {
+    if (!(priority >= 0)) {
+        throw invalid_argument("Radix heap priorities must be non-negative");
+    }
+    uint64_t key = toKey(priority);
+    if (key < last) {
+        throw invalid_argument("Radix heap priorities must not go below the last extracted one");
+    }
+    return key;
+}
+
+//==============================================================
+// Insert
+// INPUTS: Handle and its priority
+// OUTPUTS: NONE
+// Inserts a handle
+//==============================================================
+void RadixHeap::insert(int handle, double priority) {
+    if (handle < 0) {
+        throw invalid_argument("Handle must not be negative");
+    }
+    if (handle >= static_cast<int>(queued.size())) {
+        keys.resize(handle + 1, 0);
+        priorities.resize(handle + 1, 0);
+        queued.resize(handle + 1, 0);
+    }
+    if (queued[handle]) {
+        throw runtime_error("Node already exists in priority queue");
+    }
+
+    uint64_t key = checkedKey(priority);
+    keys[handle] = key;
+    priorities[handle] = priority;
+    queued[handle] = 1;
+    buckets[bucketFor(key)].push_back(make_pair(key, handle));
+    count++;
+}
+
+//==============================================================
+// findMin
+// INPUTS: NONE
+// OUTPUTS: Handle with the smallest priority, left at the back of
+//          bucket 0
+// While bucket 0 has no live entry, moves last up to the smallest
+// live key of the first non-empty bucket and spreads that bucket
+// over the lower ones. Entries only move down, so each is moved
+// at most 64 times; stale entries are dropped along the way.
+//==============================================================
+int RadixHeap::findMin() {
+    while (true) {
+        vector<pair<uint64_t, int> >& zero = buckets[0];
+        while (!zero.empty() && !live(zero.back())) {
+            zero.pop_back();
+        }
+        if (!zero.empty()) {
+            return zero.back().second;
+        }
+
+        int b = 1;
+        while (buckets[b].empty()) {
+            b++;
+        }
+
+        bool found = false;
+        uint64_t smallest = 0;
+        for (const pair<uint64_t, int>& entry : buckets[b]) {
+            if (live(entry) && (!found || entry.first < smallest)) {
+                smallest = entry.first;
+                found = true;
+            }
+        }
+        if (found) {
+            last = smallest;
+            for (const pair<uint64_t, int>& entry : buckets[b]) {
+                if (live(entry)) {
+                    buckets[bucketFor(entry.first)].push_back(entry);
+                }
+            }
+        }
+        buckets[b].clear();
+    }
+}
+
+//==============================================================
+// Extract Min
+// INPUTS: NONE
+// OUTPUTS: Pair with handle and priority
+// Takes the min value out of the heap and returns it
+//==============================================================
+pair<int, double> RadixHeap::extractMin() {
+    if (isEmpty()) {
+        throw runtime_error("Priority queue is empty");
+    }
+
+    int handle = findMin();
+    buckets[0].pop_back();
+    queued[handle] = 0;
+    count--;
+    return make_pair(handle, priorities[handle]);
+}
+
+//==============================================================
+// Peek Min
+// INPUTS: NONE
+// OUTPUTS: Pair with handle and priority
+// Returns the min value without taking it out of the heap
+//==============================================================
+pair<int, double> RadixHeap::peekMin() {
+    if (isEmpty()) {
+        throw runtime_error("Priority queue is empty");
+    }
+
+    int handle = findMin();
+    return make_pair(handle, priorities[handle]);
+}
+
+//==============================================================
+// Decrease Key
+// INPUTS: Handle to change, its new priority
+// OUTPUTS: NONE
+// Lowers the priority of a queued handle by adding an entry in
+// the bucket of its new key; a higher priority is ignored
+//==============================================================
+void RadixHeap::decreaseKey(int handle, double newPriority) {
+    if (!contains(handle)) {
+        throw runtime_error("Node not found in priority queue");
+    }
+    if (newPriority >= priorities[handle]) {
+        return;
+    }
+
+    uint64_t key = checkedKey(newPriority);
+    keys[handle] = key;
+    priorities[handle] = newPriority;
+    buckets[bucketFor(key)].push_back(make_pair(key, handle));
+}
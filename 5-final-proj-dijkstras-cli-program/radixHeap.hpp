@@ -0,0 +1,74 @@
+//=========================================================
+// RadixHeap.hpp
+// Andrew McCutchan, Namu Kim
+// Header file containing all function delcarations for
+// RadixHeap class. A monotone priority queue over dense
+// integer handles for searches whose extracted priorities
+// never decrease, such as Dijkstra with non-negative weights.
+// 12/18/2024
+//=========================================================
+
+#ifndef RADIX_HEAP_HPP
+#define RADIX_HEAP_HPP
+
+#include <iostream>
+#include <vector>
+#include <utility>
+#include <stdexcept>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+using namespace std;
+
+class RadixHeap {
+    private:
+        // bucket 0 holds keys equal to last, bucket b > 0 keys whose
+        // highest bit differing from last is bit b - 1
+        static const int BUCKETS = 65;
+
+        // bucket entries carry their key so redistributing a bucket
+        // never looks a handle up; decreaseKey adds a new entry and
+        // the old one is skipped when it turns up (its key is stale)
+        vector<pair<uint64_t, int> > buckets[BUCKETS];
+        vector<uint64_t>    keys;               // current key of each handle, as ordered bits
+        vector<double>      priorities;         // priority of each handle
+        vector<char>        queued;             // whether each handle is in the heap
+        uint64_t            last;               // key of the last extracted handle
+        int                 count;
+
+        // non-negative doubles compare the same way as their bit patterns
+        static uint64_t toKey(double priority) {
+            uint64_t key = 0;
+            if (priority != 0) {
+                memcpy(&key, &priority, sizeof(key));
+            }
+            return key;
+        }
+
+        int bucketFor(uint64_t key) const {
+            return key == last ? 0 : 64 - __builtin_clzll(key ^ last);
+        }
+
+        bool live(const pair<uint64_t, int>& entry) const {
+            return queued[entry.second] && keys[entry.second] == entry.first;
+        }
+
+        uint64_t    checkedKey(double priority) const;
+        int         findMin();
+
+    public:
+                            RadixHeap();
+                            RadixHeap(int n);
+        void                resize(int n);
+        void                insert(int handle, double priority);
+        pair<int, double>   extractMin();
+        pair<int, double>   peekMin();
+        void                decreaseKey(int handle, double newPriority);
+        void                clear();
+
+        bool                isEmpty() const { return count == 0; }
+        bool                contains(int handle) const { return handle < static_cast<int>(queued.size()) && queued[handle]; }
+        int                 size() const { return count; }
+};
+
+#endif
@@ -0,0 +1,27 @@
+//=========================================================
+// Route.hpp
+// Andrew McCutchan, Namu Kim
+// Header file containing the Route struct returned by
+// shortest path queries.
+// 12/18/2024
+//=========================================================
+
+#ifndef ROUTE_HPP
+#define ROUTE_HPP
+
+#include <vector>
+#include <utility>
+#include <limits>
+using namespace std;
+
+// Result of a shortest path query: the nodes from start to end as IDs
+// and as coordinates, and the total weight. With no path both lists
+// are empty and the weight is infinity.
+template <typename T>
+struct Route {
+    vector<T>                       ids;
+    vector<pair<double, double> >   coords;
+    double                          weight = numeric_limits<double>::infinity();
+};
+
+#endif
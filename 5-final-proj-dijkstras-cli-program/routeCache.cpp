@@ -0,0 +1,137 @@
+//=========================================================
+// RouteCache.cpp
+// Andrew McCutchan, Namu Kim
+// Implementaiton file for RouteCache class
+// 12/18/2024
+//=========================================================
+
+#include "routeCache.hpp"
+
+//==============================================================
+// Constructor
+// INPUTS: Most routes to keep, 0 for no caching
+// OUTPUTS: NONE
+//==============================================================
+template <class T>
+RouteCache<T>::RouteCache(size_t capacity) {
+    limit = capacity;
+    hitCount = 0;
+    missCount = 0;
+}
+
+//==============================================================
+// Copy Constructor
+// INPUTS: Other cache
+// OUTPUTS: NONE
+// Copies the capacity only; a copied graph starts with an empty
+// cache and fresh counters
+//==============================================================
+template <class T>
+RouteCache<T>::RouteCache(const RouteCache& other) : RouteCache(other.capacity()) {}
+
+//==============================================================
+// Assignment Operator
+// INPUTS: Other cache
+// OUTPUTS: This cache, emptied, with the other's capacity
+//==============================================================
+template <class T>
+RouteCache<T>& RouteCache<T>::operator=(const RouteCache<T>& other) {
+    if (this != &other) {
+        size_t capacity = other.capacity();
+        lock_guard<mutex> guard(lock);
+        entries.clear();
+        index.clear();
+        limit = capacity;
+        hitCount = 0;
+        missCount = 0;
+    }
+    return *this;
+}
+
+//==============================================================
+// lookup
+// INPUTS: Start and end node IDs, route to copy a hit into
+// OUTPUTS: Whether the route was cached
+// A hit becomes the most recently used route. Every call counts
+// as a hit or a miss while the cache is on.
+//==============================================================
+template <class T>
+bool RouteCache<T>::lookup(const T& start, const T& end, Route<T>& route) {
+    lock_guard<mutex> guard(lock);
+    if (limit == 0) {
+        return false;
+    }
+
+    auto found = index.find(make_pair(start, end));
+    if (found == index.end()) {
+        missCount++;
+        return false;
+    }
+    entries.splice(entries.begin(), entries, found->second);
+    route = found->second->second;
+    hitCount++;
+    return true;
+}
+
+//==============================================================
+// store
+// INPUTS: Start and end node IDs, route between them
+// OUTPUTS: NONE
+// Adds or refreshes a route, dropping the least recently used
+// one when the cache is full
+//==============================================================
+template <class T>
+void RouteCache<T>::store(const T& start, const T& end, const Route<T>& route) {
+    lock_guard<mutex> guard(lock);
+    if (limit == 0) {
+        return;
+    }
+
+    pair<T, T> key = make_pair(start, end);
+    auto found = index.find(key);
+    if (found != index.end()) {
+        found->second->second = route;
+        entries.splice(entries.begin(), entries, found->second);
+        return;
+    }
+
+    if (entries.size() >= limit) {
+        index.erase(entries.back().first);
+        entries.pop_back();
+    }
+    entries.emplace_front(key, route);
+    index[key] = entries.begin();
+}
+
+//==============================================================
+// setCapacity
+// INPUTS: Most routes to keep, 0 to turn the cache off
+// OUTPUTS: NONE
+// Drops the least recently used routes that no longer fit
+//==============================================================
+template <class T>
+void RouteCache<T>::setCapacity(size_t capacity) {
+    lock_guard<mutex> guard(lock);
+    limit = capacity;
+    while (entries.size() > limit) {
+        index.erase(entries.back().first);
+        entries.pop_back();
+    }
+}
+
+//==============================================================
+// clear
+// INPUTS: NONE
+// OUTPUTS: NONE
+// Forgets every cached route, keeping the capacity and counters
+//==============================================================
+template <class T>
+void RouteCache<T>::clear() {
+    lock_guard<mutex> guard(lock);
+    entries.clear();
+    index.clear();
+}
+
+template class RouteCache<long>;
+template class RouteCache<long long>;
+template class RouteCache<int>;
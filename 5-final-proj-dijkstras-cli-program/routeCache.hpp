@@ -0,0 +1,55 @@
+//=========================================================
+// RouteCache.hpp
+// Andrew McCutchan, Namu Kim
+// Header file containing all function delcarations for
+// RouteCache class. A bounded, thread-safe least recently
+// used cache of routes keyed by (start ID, end ID).
+// 12/18/2024
+//=========================================================
+
+#ifndef ROUTE_CACHE_HPP
+#define ROUTE_CACHE_HPP
+
+#include <list>
+#include <unordered_map>
+#include <functional>
+#include <mutex>
+#include "route.hpp"
+using namespace std;
+
+template <typename T>
+class RouteCache {
+    private:
+        struct KeyHash {
+            size_t operator()(const pair<T, T>& key) const {
+                size_t h = hash<T>()(key.first);
+                return h ^ (hash<T>()(key.second) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2));
+            }
+        };
+
+        // most recently used first; the map points into the list
+        list<pair<pair<T, T>, Route<T> > > entries;
+        unordered_map<pair<T, T>, typename list<pair<pair<T, T>, Route<T> > >::iterator, KeyHash> index;
+        size_t              limit;      // most routes kept, 0 turns the cache off
+        long long           hitCount;
+        long long           missCount;
+        mutable mutex       lock;
+
+    public:
+                            RouteCache(size_t capacity = 0);
+                            RouteCache(const RouteCache& other);
+        RouteCache&         operator=(const RouteCache& other);
+        bool                lookup(const T& start, const T& end, Route<T>& route);
+        void                store(const T& start, const T& end, const Route<T>& route);
+        void                setCapacity(size_t capacity);
+        void                clear();
+
+        // getter functions
+        bool                enabled() const { lock_guard<mutex> guard(lock); return limit > 0; }
+        size_t              capacity() const { lock_guard<mutex> guard(lock); return limit; }
+        size_t              size() const { lock_guard<mutex> guard(lock); return entries.size(); }
+        long long           hits() const { lock_guard<mutex> guard(lock); return hitCount; }
+        long long           misses() const { lock_guard<mutex> guard(lock); return missCount; }
+};
+
+#endif
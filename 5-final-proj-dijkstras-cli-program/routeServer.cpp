@@ -0,0 +1,273 @@
+//=========================================================
+// RouteServer.cpp
+// Andrew McCutchan, Namu Kim
+// Implementaiton file for RouteServer class
+// 12/18/2024
+//=========================================================
+
+#include "routeServer.hpp"
+#include <charconv>
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Stream buffer over a socket so a connection can be served like any
+// other stream. Writes use MSG_NOSIGNAL, so a client that hangs up
+// before reading its answers fails the stream instead of raising
+// SIGPIPE and killing the server.
+class SocketBuffer : public streambuf {
+    private:
+        int     fd;
+        char    input[65536];
+        char    output[65536];
+
+    protected:
+        int underflow() override {
+            ssize_t got;
+            do {
+                got = read(fd, input, sizeof(input));
+            } while (got < 0 && errno == EINTR);
+            if (got <= 0) {
+                return traits_type::eof();
+            }
+            setg(input, input, input + got);
+            return traits_type::to_int_type(input[0]);
+        }
+
+        int overflow(int c) override {
+            if (sync() != 0) {
+                return traits_type::eof();
+            }
+            if (c != traits_type::eof()) {
+                *pptr() = c;
+                pbump(1);
+            }
+            return traits_type::not_eof(c);
+        }
+
+        int sync() override {
+            const char* next = pbase();
+            while (next < pptr()) {
+                ssize_t sent = send(fd, next, pptr() - next, MSG_NOSIGNAL);
+                if (sent < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (sent <= 0) {
+                    return -1;
+                }
+                next += sent;
+            }
+            setp(output, output + sizeof(output));
+            return 0;
+        }
+
+    public:
+        SocketBuffer(int fd) : fd(fd) {
+            setg(input, input, input);
+            setp(output, output + sizeof(output));
+        }
+};
+
+//==============================================================
+// Constructor
+// INPUTS: Graph file (text or binary), number of threads (0 for
+//         one per core)
+// OUTPUTS: NONE
+// Loads and freezes the graph once for every query to share
+//==============================================================
+template <class T>
+RouteServer<T>::RouteServer(const string& graphFile, int threads)
+    : RouteServer(WeightedGraph<T>::readFromFile(graphFile), threads) {}
+
+//==============================================================
+// Constructor
+// INPUTS: Graph to answer queries on, number of threads (0 for
+//         one per core)
+// OUTPUTS: NONE
+//==============================================================
+template <class T>
+RouteServer<T>::RouteServer(WeightedGraph<T> graph, int threads)
+    : graph(move(graph)), csr(this->graph.freeze()) {
+    this->threads = threadCount(threads);
+    workspaces.resize(this->threads);
+    paths.resize(this->threads);
+    queries.resize(BATCH);
+    lineNumbers.resize(BATCH);
+    answers.resize(BATCH);
+}
+
+//==============================================================
+// answer
+// INPUTS: One query line, its line number, workspace to search
+//         with, scratch path, string to write the answer into
+// OUTPUTS: NONE
+// Only reads the frozen graph, so threads can answer queries at
+// the same time as long as each has its own workspace
+//==============================================================
+template <class T>
+void RouteServer<T>::answer(const string& query, int lineNumber, SearchWorkspace& ws, vector<int>& path, string& result) const {
+    result.clear();
+    try {
+        GraphParser parser(query.data(), query.data() + query.size(), lineNumber);
+        double startX = parser.readDouble("start x");
+        double startY = parser.readDouble("start y");
+        double endX = parser.readDouble("end x");
+        double endY = parser.readDouble("end y");
+        parser.endLine();
+
+        int source = csr.locate(make_pair(startX, startY));
+        int target = csr.locate(make_pair(endX, endY));
+        if (source == -1 || target == -1) {
+            throw parse_exception(lineNumber, "start or end coord not found");
+        }
+        if (isinf(csr.dijkstras(source, target, ws))) {
+            result = "no path";
+            return;
+        }
+
+        char number[32];
+        char* last = to_chars(number, number + sizeof(number), ws.distance(target)).ptr;
+        result.append(number, last);
+        ws.path(target, path);
+        for (int u : path) {
+            last = to_chars(number, number + sizeof(number), csr.nodeId(u)).ptr;
+            result += ' ';
+            result.append(number, last);
+        }
+    } catch (const parse_exception& e) {
+        result = string("error: ") + e.what();
+    }
+}
+
+//==============================================================
+// answerBatch
+// INPUTS: Number of queries in the current batch
+// OUTPUTS: NONE
+// Hands the queries out to the threads one at a time; each thread
+// writes into the answer slot of its query, so order is kept
+//==============================================================
+template <class T>
+void RouteServer<T>::answerBatch(int count) {
+    atomic<int> next(0);
+    int workers = min(threads, count);
+    auto work = [&](int t) {
+        for (int i = next++; i < count; i = next++) {
+            answer(queries[i], lineNumbers[i], workspaces[t], paths[t], answers[i]);
+        }
+    };
+    if (workers <= 1) {
+        work(0);
+    }
+    else {
+        runParallel(workers, work);
+    }
+}
+
+//==============================================================
+// serve
+// INPUTS: Stream of queries, stream to write answers to, whether
+//         to answer as soon as no more input is waiting
+// OUTPUTS: Number of queries answered
+// Reads up to BATCH queries at a time, answers them on all threads
+// and writes the answers in order, stopping once the output fails.
+// An interactive batch also ends when the input has nothing more
+// buffered, so a client gets its answers without having to send a
+// full batch.
+//==============================================================
+template <class T>
+long long RouteServer<T>::serve(istream& in, ostream& out, bool interactive) {
+    long long answered = 0;
+    int lineNumber = 0;
+    while (in) {
+        int count = 0;
+        while (count < BATCH && getline(in, queries[count])) {
+            lineNumber++;
+            if (queries[count].find_first_not_of(" \t\r") != string::npos) {
+                lineNumbers[count++] = lineNumber;
+            }
+            if (interactive && in.rdbuf()->in_avail() <= 0) {
+                break;
+            }
+        }
+
+        answerBatch(count);
+        for (int i = 0; i < count; i++) {
+            out << answers[i] << '\n';
+        }
+        out.flush();
+        if (!out) {
+            break;
+        }
+        answered += count;
+    }
+    return answered;
+}
+
+//==============================================================
+// serveFile
+// INPUTS: File of queries, stream to write answers to
+// OUTPUTS: Number of queries answered
+//==============================================================
+template <class T>
+long long RouteServer<T>::serveFile(const string& queryFile, ostream& out) {
+    ifstream in(queryFile);
+    if (!in) {
+        throw runtime_error("Could not open " + queryFile);
+    }
+    return serve(in, out);
+}
+
+//==============================================================
+// serveSocket
+// INPUTS: Path of a Unix domain socket to listen on, number of
+//         connections to serve before returning (0 for no limit)
+// OUTPUTS: NONE
+// Serves one client connection at a time; each connection is a
+// stream of queries answered like serve(), and the graph stays
+// loaded between connections. A client that disconnects early
+// only ends its own connection.
+//==============================================================
+template <class T>
+void RouteServer<T>::serveSocket(const string& socketPath, int maxConnections) {
+    sockaddr_un address = {};
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        throw invalid_argument("Socket path is too long");
+    }
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, socketPath.c_str());
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) {
+        throw runtime_error("Could not create socket");
+    }
+    unlink(socketPath.c_str());
+    if (::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listener, 16) != 0) {
+        close(listener);
+        throw runtime_error("Could not listen on " + socketPath);
+    }
+
+    for (int served = 0; maxConnections == 0 || served < maxConnections; served++) {
+        int client = accept(listener, nullptr, nullptr);
+        if (client < 0) {
+            if (errno == EINTR) {
+                served--;
+                continue;
+            }
+            close(listener);
+            throw runtime_error("Could not accept a connection on " + socketPath);
+        }
+        SocketBuffer buffer(client);
+        istream in(&buffer);
+        ostream out(&buffer);
+        serve(in, out, true);
+        close(client);
+    }
+    close(listener);
+    unlink(socketPath.c_str());
+}
+
+template class RouteServer<long>;
+template class RouteServer<long long>;
+template class RouteServer<int>;
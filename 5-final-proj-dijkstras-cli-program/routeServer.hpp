@@ -0,0 +1,61 @@
+//=========================================================
+// RouteServer.hpp
+// Andrew McCutchan, Namu Kim
+// Header file containing all function delcarations for
+// RouteServer class. A RouteServer loads a graph once and
+// answers batches of route queries from a file, a stream or
+// a local socket on several threads, writing the answers in
+// the order the queries arrived.
+// 12/18/2024
+//=========================================================
+
+#ifndef ROUTE_SERVER_HPP
+#define ROUTE_SERVER_HPP
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <stdexcept>
+#include "weightedGraph.hpp"
+#include "parallel.hpp"
+using namespace std;
+
+// Queries are one per line: "startX startY endX endY". Each gets one
+// line back: "weight id id ... id" for the nodes on the path, "no path",
+// or "error: line N: ..." for a query that can't be answered. Blank
+// lines are skipped.
+// Answers come back a batch at a time; an interactive client gets the
+// answers to what it has sent so far without waiting for a full batch.
+template <typename T>
+class RouteServer {
+    private:
+        static const int BATCH = 16384;     // most queries answered per round
+
+        WeightedGraph<T>        graph;      // never edited once loaded
+        const CSRGraph<T>&      csr;        // frozen copy every thread searches
+        int                     threads;
+        vector<SearchWorkspace> workspaces; // one per thread, kept between batches
+        vector<vector<int> >    paths;      // one per thread, for the path being written
+        vector<string>          queries;    // current batch and its answers,
+        vector<int>             lineNumbers;//   reused from batch to batch
+        vector<string>          answers;
+
+        void            answer(const string& query, int lineNumber, SearchWorkspace& ws, vector<int>& path, string& result) const;
+        void            answerBatch(int count);
+
+    public:
+                        RouteServer(const string& graphFile, int threads = 0);
+                        RouteServer(WeightedGraph<T> graph, int threads = 0);
+                        RouteServer(const RouteServer&) = delete;
+        RouteServer&    operator=(const RouteServer&) = delete;
+        long long       serve(istream& in, ostream& out, bool interactive = false);
+        long long       serveFile(const string& queryFile, ostream& out);
+        void            serveSocket(const string& socketPath, int maxConnections = 0);
+
+        // getter functions
+        int             threadTotal() const { return threads; }
+};
+
+#endif
@@ -0,0 +1,86 @@
+//=========================================================
+// SearchWorkspace.cpp
+// Andrew McCutchan, Namu Kim
+// Implementaiton file for SearchWorkspace class
+// 12/18/2024
+//=========================================================
+
+#include "searchWorkspace.hpp"
+
+//==============================================================
+// Default Constructor
+// INPUTS: NONE
+// OUTPUTS: NONE
+// Creates an empty workspace, sized on the first reset
+//==============================================================
+SearchWorkspace::SearchWorkspace() {
+    generation = 0;
+    settled = 0;
+    queueType = BINARY_HEAP;
+}
+
+//==============================================================
+// reset
+// INPUTS: Number of nodes in the graph being searched
+// OUTPUTS: NONE
+// Starts a new query. The arrays are only (re)allocated when the
+// graph size changes; otherwise bumping the generation forgets
+// every distance from the last query in O(1). Only the queue that
+// queueType selects is sized, the first time it is used, so a
+// workspace doesn't pay for queues it never uses.
+//==============================================================
+void SearchWorkspace::reset(int n) {
+    if (static_cast<int>(stamp.size()) != n) {
+        dist.assign(n, numeric_limits<double>::infinity());
+        parent.assign(n, -1);
+        stamp.assign(n, 0);
+        generation = 0;
+    }
+
+    generation++;
+    if (generation == 0) {
+        // the counter wrapped around, old stamps could look current
+        fill(stamp.begin(), stamp.end(), 0);
+        generation = 1;
+    }
+
+    // resizing to the size a queue already has only empties it; the
+    // other queues are emptied in case queueType changed since they
+    // were used (A* and bidirectional search always use queue), which
+    // costs nothing when they hold no entries
+    switch (queueType) {
+        case RADIX_HEAP:    radixQueue.resize(n); queue.clear(); dialQueue.clear(); break;
+        case DIAL_BUCKETS:  dialQueue.resize(n); queue.clear(); radixQueue.clear(); break;
+        default:            queue.resize(n); radixQueue.clear(); dialQueue.clear(); break;
+    }
+    settled = 0;
+}
+
+//==============================================================
+// path
+// INPUTS: Target node
+// OUTPUTS: Nodes on the path from the source to the target found
+//          by the last query, empty if the target was not reached
+//==============================================================
+vector<int> SearchWorkspace::path(int target) const {
+    vector<int> nodes;
+    path(target, nodes);
+    return nodes;
+}
+
+//==============================================================
+// path
+// INPUTS: Target node, vector to write the path into
+// OUTPUTS: NONE
+// Same as above, but reuses the memory of the caller's vector
+//==============================================================
+void SearchWorkspace::path(int target, vector<int>& nodes) const {
+    nodes.clear();
+    if (!reached(target)) {
+        return;
+    }
+    for (int u = target; u != -1; u = parentOf(u)) {
+        nodes.push_back(u);
+    }
+    reverse(nodes.begin(), nodes.end());
+}
@@ -0,0 +1,57 @@
+//=========================================================
+// SearchWorkspace.hpp
+// Andrew McCutchan, Namu Kim
+// Header file containing all function delcarations for
+// SearchWorkspace class. A SearchWorkspace holds the per-query
+// state of a shortest path search (distances, parents and the
+// queue) so it can be reused from one query to the next.
+// 12/18/2024
+//=========================================================
+
+#ifndef SEARCH_WORKSPACE_HPP
+#define SEARCH_WORKSPACE_HPP
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include "indexedPriorityQueue.hpp"
+#include "radixHeap.hpp"
+#include "dialQueue.hpp"
+using namespace std;
+
+// queue used by dijkstras() and oneToMany(); the radix heap and the
+// bucket queue need non-negative edge weights
+enum QueueType {
+    BINARY_HEAP,
+    RADIX_HEAP,
+    DIAL_BUCKETS
+};
+
+class SearchWorkspace {
+    private:
+        // dist and parent of u are only valid when stamp[u] equals the
+        // current generation, so starting a new query never touches them
+        vector<double>      dist;
+        vector<int>         parent;
+        vector<unsigned>    stamp;
+        unsigned            generation;
+
+    public:
+        IndexedPriorityQueue<> queue;
+        RadixHeap           radixQueue;
+        DialQueue           dialQueue;
+        QueueType           queueType;  // which of the three queues searches that support it use
+        int                 settled;    // nodes extracted by the last query
+
+                            SearchWorkspace();
+        void                reset(int n);
+        vector<int>         path(int target) const;
+        void                path(int target, vector<int>& nodes) const;
+
+        bool                reached(int u) const { return stamp[u] == generation; }
+        double              distance(int u) const { return reached(u) ? dist[u] : numeric_limits<double>::infinity(); }
+        int                 parentOf(int u) const { return reached(u) ? parent[u] : -1; }
+        void                update(int u, double d, int p) { stamp[u] = generation; dist[u] = d; parent[u] = p; }
+};
+
+#endif
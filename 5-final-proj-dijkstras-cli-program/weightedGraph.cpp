@@ -6,6 +6,7 @@
 //=========================================================
 
 #include "weightedGraph.hpp"
+#include <atomic>
 
 //==============================================================
 // Default Constructor
@@ -16,6 +17,10 @@
 template <class T>
 WeightedGraph<T>::WeightedGraph() {
     listSize = 0;
+    frozen = false;
+    nodeOrder = ID_ORDER;
+    contracted = false;
+    thawed = true;
 }
 
 //==============================================================
@@ -30,6 +35,13 @@ WeightedGraph<T>::WeightedGraph(const WeightedGraph<T> &other) {
     listSize = other.listSize;
     coords = other.coords;
     adjacencyList = other.adjacencyList;
+    csr = other.csr;
+    frozen = other.frozen;
+    nodeOrder = other.nodeOrder;
+    hierarchy = other.hierarchy;
+    contracted = other.contracted;
+    thawed = other.thawed.load();
+    routeCache = other.routeCache;
 }
 
 //==============================================================
@@ -51,6 +63,13 @@ WeightedGraph<T>& WeightedGraph<T>::operator=(const WeightedGraph<T> &other) {
     coords = other.coords;
     adjacencyList = other.adjacencyList;
     listSize = other.listSize;
+    csr = other.csr;
+    frozen = other.frozen;
+    nodeOrder = other.nodeOrder;
+    hierarchy = other.hierarchy;
+    contracted = other.contracted;
+    thawed = other.thawed.load();
+    routeCache = other.routeCache;
     return *this;
 }
 
@@ -62,7 +81,11 @@ WeightedGraph<T>& WeightedGraph<T>::operator=(const WeightedGraph<T> &other) {
 //==============================================================
 template <class T>
 void WeightedGraph<T>::addEdge(const T& u, const T& v, double weight) {
+    thaw();
     adjacencyList[u][v] = weight;
+    frozen = false;
+    contracted = false;
+    routeCache.clear();
 }
 
 //============================================================== 
@@ -72,6 +95,7 @@ void WeightedGraph<T>::addEdge(const T& u, const T& v, double weight) {
 //==============================================================
 template <class T>
 bool WeightedGraph<T>::edgeIn(const T& u, const T& v) {
+    thaw();
     return adjacencyList[u].find(v) != adjacencyList[u].end();
 }
 
@@ -83,83 +107,175 @@ bool WeightedGraph<T>::edgeIn(const T& u, const T& v) {
 //==============================================================
 template <class T>
 void WeightedGraph<T>::addVertex(const T& id, double x, double y) {
+    thaw();
     coords[id] = make_pair(x, y);
+    frozen = false;
+    contracted = false;
+    routeCache.clear();
 }
 
 //==============================================================
-// readFromSTDIN
-// INPUTS: NONE
+// parse
+// INPUTS: Parser positioned at the start of a graph
 // OUTPUTS: Weighted Graph object
-// Reads a graph inputed from STDIN
+// Reads the "n m" header, n vertex lines "ID x y" and m edge lines
+// "U V W [S]". The optional street name S is skipped. Blank lines
+// are ignored, anything else malformed throws a parse_exception
+// naming the line.
 //==============================================================
 template <class T>
-WeightedGraph<T> WeightedGraph<T>::readFromSTDIN() {
-    int n, m;
-    cin >> n >> m;
+WeightedGraph<T> WeightedGraph<T>::parse(GraphParser& parser) {
+    if (!parser.skipBlankLines()) {
+        throw parse_exception(parser.line(), "missing vertex and edge counts");
+    }
+    int n = parser.readInteger<int>("vertex count");
+    int m = parser.readInteger<int>("edge count");
+    parser.endLine();
 
     WeightedGraph<T> g;
     g.listSize = n;
+    g.coords.reserve(n);
+    g.adjacencyList.reserve(n);
 
     for (int i = 0; i < n; i++) {
-        T id;
-        double x, y;
-        cin >> id >> x >> y;
+        if (!parser.skipBlankLines()) {
+            throw parse_exception(parser.line(), "expected " + to_string(n) + " vertices, found " + to_string(i));
+        }
+        T id = parser.readInteger<T>("node ID");
+        double x = parser.readDouble("x coordinate");
+        double y = parser.readDouble("y coordinate");
+        parser.endLine();
         g.addVertex(id, x, y);
     }
 
-    for (int i = 0; i < m + 1; i++) {
-        string line;
-        getline(cin, line);
-        istringstream street(line);
-
-        T u, v;
-        double weight;
-        if (street >> u >> v >> weight) {
-            g.addEdge(u, v, weight);
-        }  
+    for (int i = 0; i < m; i++) {
+        if (!parser.skipBlankLines()) {
+            throw parse_exception(parser.line(), "expected " + to_string(m) + " edges, found " + to_string(i));
+        }
+        T u = parser.readInteger<T>("edge start");
+        T v = parser.readInteger<T>("edge end");
+        double weight = parser.readDouble("edge weight");
+        parser.readRest();  // street name, not used yet
+        parser.endLine();
+        g.addEdge(u, v, weight);
     }
+    g.freeze();
     return g;
 }
 
+//==============================================================
+// readFromSTDIN
+// INPUTS: NONE
+// OUTPUTS: Weighted Graph object
+// Reads a graph inputed from STDIN
+//==============================================================
+template <class T>
+WeightedGraph<T> WeightedGraph<T>::readFromSTDIN() {
+    GraphParser parser(cin);
+    return parse(parser);
+}
+
 //==============================================================
 // readFromFile
 // INPUTS: File
 // OUTPUTS: Weighted Graph object
-// Reads a file from parameter
+// Reads a file from parameter. Files written by writeBinary are
+// recognised by their header and memory-mapped instead of parsed.
 //==============================================================
 template <class T>
 WeightedGraph<T> WeightedGraph<T>::readFromFile(const string& filename) {
-    int n, m;
-    ifstream file(filename);
-
-    if (!file) {
-        throw runtime_error("file not found");
+    if (CSRGraph<T>::isBinaryFile(filename)) {
+        return readFromBinary(filename);
     }
+    GraphParser parser(filename);
+    return parse(parser);
+}
 
-    file >> n >> m;
+//==============================================================
+// readFromFileParallel
+// INPUTS: File, number of threads (0 for one per core)
+// OUTPUTS: Weighted Graph object
+// Reads the same files as readFromFile, but parses the edge lines
+// on several threads and builds the CSR copy directly from them.
+// Like a binary file, the hash maps are only filled in if the
+// graph is edited or inspected through them.
+//==============================================================
+template <class T>
+WeightedGraph<T> WeightedGraph<T>::readFromFileParallel(const string& filename, int threads) {
+    if (CSRGraph<T>::isBinaryFile(filename)) {
+        return readFromBinary(filename);
+    }
+    ParallelLoader<T> loader(filename, threads);
     WeightedGraph<T> g;
-    g.listSize = n;
+    g.csr = loader.build();
+    g.frozen = true;
+    g.thawed = false;
+    g.listSize = loader.numVertexLines();
+    return g;
+}
 
-    for (int i = 0; i < n; i++) {
-        T id;
-        double x, y;
-        file >> id >> x >> y;
-        g.coords[id] = make_pair(x, y);
+//==============================================================
+// readFromBinary
+// INPUTS: File written by writeBinary, whether to verify its checksum
+// OUTPUTS: Weighted Graph object
+// Memory-maps a binary graph file. The graph is ready to search as
+// soon as the file is mapped; the hash maps are only rebuilt from
+// the CSR arrays if the graph is edited or inspected through them.
+//==============================================================
+template <class T>
+WeightedGraph<T> WeightedGraph<T>::readFromBinary(const string& filename, bool verify) {
+    WeightedGraph<T> g;
+    g.csr = CSRGraph<T>::mapFile(filename, verify);
+    g.frozen = true;
+    g.thawed = false;
+    for (int u = 0; u < g.csr.numNodes(); u++) {
+        if (!isnan(g.csr.coord(u).first)) {
+            g.listSize++;
+        }
     }
+    return g;
+}
 
-    for (int i = 0; i < m + 1; i++) {
-        string line;
-        getline(file, line);
-        istringstream street(line);
+//==============================================================
+// writeBinary
+// INPUTS: File name
+// OUTPUTS: NONE
+// Saves the frozen graph in the binary format read by readFromBinary
+//==============================================================
+template <class T>
+void WeightedGraph<T>::writeBinary(const string& filename) {
+    freeze().save(filename);
+}
 
-        T u, v;
-        double weight;
-        if (street >> u >> v >> weight) {
-            g.addEdge(u, v, weight);
-        }  
+//==============================================================
+// thaw
+// INPUTS: NONE
+// OUTPUTS: NONE
+// Rebuilds coords and adjacencyList from the CSR arrays of a graph
+// read from a binary file, the first time something needs them.
+// The const getters call this too, so the first fill happens under
+// a lock and other threads wait for it instead of racing on the
+// maps.
+//==============================================================
+template <class T>
+void WeightedGraph<T>::thaw() const {
+    if (thawed.load(memory_order_acquire)) {
+        return;
     }
-    file.close();
-    return g;
+    lock_guard<mutex> guard(thawLock);
+    if (thawed.load(memory_order_relaxed)) {
+        return;
+    }
+    for (int u = 0; u < csr.numNodes(); u++) {
+        T id = csr.nodeId(u);
+        if (!isnan(csr.coord(u).first)) {
+            coords[id] = csr.coord(u);
+        }
+        for (int e = csr.edgeBegin(u); e < csr.edgeEnd(u); e++) {
+            adjacencyList[id][csr.nodeId(csr.target(e))] = csr.weight(e);
+        }
+    }
+    thawed.store(true, memory_order_release);
 }
 
 //==============================================================
@@ -168,54 +284,437 @@ WeightedGraph<T> WeightedGraph<T>::readFromFile(const string& filename) {
 // OUTPUTS: Vector of shortest path coordinates
 // Computes the shortest path between two nodes. This function takes
 // coordinates inputted by the user and gets their associated nodes,
-// then computes the shortest path between the two.
+// then computes the shortest path between the two over the frozen
+// CSR copy of the graph.
 //==============================================================
 template <class T>
 vector<pair<double, double> > WeightedGraph<T>::dijkstras(pair<double, double> start, pair<double, double> end) {
-    pair<double, double> startAndEndNodes = findNode(start, end);
+    vector<pair<double, double> > route;
+    dijkstras(start, end, workspace, route);
+    return route;
+}
+
+//==============================================================
+// dijkstras
+// INPUTS: start and end coordinates, workspace to search with,
+//         vector to write the path coordinates into
+// OUTPUTS: Weight of the shortest path, infinity if there is none
+// Same search as above, but the caller owns the workspace and the
+// route, so repeated queries reuse their memory and allocate
+// nothing once they have grown. Each thread can keep its own
+// workspace and query a frozen graph at the same time. If there is
+// no path, route holds just the end coordinates. With the route
+// cache on, the search goes through a Route and does allocate.
+//==============================================================
+template <class T>
+double WeightedGraph<T>::dijkstras(pair<double, double> start, pair<double, double> end,
+                                   SearchWorkspace& ws, vector<pair<double, double> >& route) {
+    const CSRGraph<T>& g = freeze();
+    int source = g.locate(start);
+    int target = g.locate(end);
+    if (source == -1 || target == -1) {
+        throw invalid_argument("Start or end coord not found");
+    }
+
+    if (routeCache.enabled()) {
+        Route<T> found;
+        dijkstras(start, end, ws, found);
+        route = found.coords;
+        if (route.empty()) {
+            route.push_back(g.coord(target));
+        }
+        return found.weight;
+    }
+
+    double weight = g.dijkstras(source, target, ws);
+    route.clear();
+    if (!ws.reached(target)) {
+        route.push_back(g.coord(target));
+        return weight;
+    }
+    for (int u = target; u != -1; u = ws.parentOf(u)) {
+        route.push_back(g.coord(u));
+    }
+    reverse(route.begin(), route.end());
+    return weight;
+}
+
+//==============================================================
+// dijkstras
+// INPUTS: start and end coordinates, workspace to search with,
+//         route to fill in
+// OUTPUTS: Weight of the shortest path, infinity if there is none
+// Fills the route with the node IDs, coordinates and weight of the
+// path straight from the search, so nothing has to be looked up
+// again afterwards. Like the overload above, it reuses the memory
+// of the workspace and route. A route already in the route cache
+// is copied from there without searching.
+//==============================================================
+template <class T>
+double WeightedGraph<T>::dijkstras(pair<double, double> start, pair<double, double> end,
+                                   SearchWorkspace& ws, Route<T>& route) {
+    const CSRGraph<T>& g = freeze();
+    int source = g.locate(start);
+    int target = g.locate(end);
+    if (source == -1 || target == -1) {
+        throw invalid_argument("Start or end coord not found");
+    }
+
+    if (routeCache.lookup(g.nodeId(source), g.nodeId(target), route)) {
+        return route.weight;
+    }
+    findRoute(source, target, ws, route);
+    routeCache.store(g.nodeId(source), g.nodeId(target), route);
+    return route.weight;
+}
 
-    PriorityQueue<T> pq;
-    unordered_map<T, pair<T, double> > S;
+//==============================================================
+// findRoute
+// INPUTS: Dense start and end indices, workspace to search with,
+//         route to fill in
+// OUTPUTS: Weight of the shortest path, infinity if there is none
+//==============================================================
+template <class T>
+double WeightedGraph<T>::findRoute(int source, int target, SearchWorkspace& ws, Route<T>& route) const {
+    route.weight = csr.dijkstras(source, target, ws);
+    route.ids.clear();
+    route.coords.clear();
+    if (!ws.reached(target)) {
+        return route.weight;
+    }
+    for (int u = target; u != -1; u = ws.parentOf(u)) {
+        route.ids.push_back(csr.nodeId(u));
+        route.coords.push_back(csr.coord(u));
+    }
+    reverse(route.ids.begin(), route.ids.end());
+    reverse(route.coords.begin(), route.coords.end());
+    return route.weight;
+}
+
+//==============================================================
+// shortestRoute
+// INPUTS: start and end coordinates
+// OUTPUTS: Node IDs, coordinates and weight of the shortest path
+//==============================================================
+template <class T>
+Route<T> WeightedGraph<T>::shortestRoute(pair<double, double> start, pair<double, double> end) {
+    Route<T> route;
+    dijkstras(start, end, workspace, route);
+    return route;
+}
+
+//==============================================================
+// kShortestPaths
+// INPUTS: start and end coordinates, number of routes, number of
+//         threads (0 for one per core)
+// OUTPUTS: Up to k loopless routes from start to end, shortest
+//          first
+// Alternative routes by Yen's algorithm (see KShortestPaths). To
+// reuse the search state across many queries, keep a
+// KShortestPaths over freeze() instead.
+//==============================================================
+template <class T>
+vector<Route<T> > WeightedGraph<T>::kShortestPaths(pair<double, double> start, pair<double, double> end, int k, int threads) {
+    const CSRGraph<T>& g = freeze();
+    int source = g.locate(start);
+    int target = g.locate(end);
+    if (source == -1 || target == -1) {
+        throw invalid_argument("Start or end coord not found");
+    }
+    KShortestPaths<T> finder(g, threads);
+    return finder.find(source, target, k);
+}
+
+//==============================================================
+// oneToAll
+// INPUTS: start coordinates, arrays to write into, distance cutoff
+//         (none by default)
+// OUTPUTS: Number of nodes within the cutoff, start included
+// Runs one search from the start and keeps its whole shortest path
+// tree. Both arrays are indexed by dense node index (see freeze()
+// for coord and nodeId): distances[u] is the distance from the
+// start and parents[u] the previous node on the way, infinity and
+// -1 for nodes past the cutoff or out of reach.
+//==============================================================
+template <class T>
+int WeightedGraph<T>::oneToAll(pair<double, double> start, vector<double>& distances, vector<int>& parents, double cutoff) {
+    const CSRGraph<T>& g = freeze();
+    int source = g.locate(start);
+    if (source == -1) {
+        throw invalid_argument("Start coord not found");
+    }
+    return g.oneToAll(source, cutoff, workspace, distances, parents);
+}
 
-    for (const auto& [node, _] : adjacencyList) { 
-        // S[node].first = parent
-        // S[node].second = shortest path estimate from source (node.d)
-        S[node].first = -1;
-        S[node].second = numeric_limits<double>::infinity();
-        pq.insert(node, S[node].second);
+//==============================================================
+// parallelOneToAll
+// INPUTS: start coordinates, array to write into, bucket width (0
+//         for the mean edge weight), number of threads (0 for one
+//         per core)
+// OUTPUTS: Number of nodes reached, start included
+// Same distances as oneToAll with no cutoff, found by delta
+// stepping on several threads (see DeltaStepping). Only distances
+// are kept. For many searches keep a DeltaStepping over freeze()
+// instead, so its arrays are reused.
+//==============================================================
+template <class T>
+int WeightedGraph<T>::parallelOneToAll(pair<double, double> start, vector<double>& distances, double delta, int threads) {
+    const CSRGraph<T>& g = freeze();
+    int source = g.locate(start);
+    if (source == -1) {
+        throw invalid_argument("Start coord not found");
     }
+    DeltaStepping<T> engine(g, threads);
+    engine.setDelta(delta);
+    return engine.run(source, distances);
+}
 
-    S[startAndEndNodes.first].second = 0;// s.d = 0
-    pq.decreaseKey(startAndEndNodes.first, 0);  
+//==============================================================
+// isochrones
+// INPUTS: start coordinates, upper distance of each band in
+//         increasing order
+// OUTPUTS: Coordinates of the nodes in each band
+// Band i holds the nodes whose distance from the start is above
+// bands[i - 1] (or at least 0 for the first band) and no more than
+// bands[i]. A single search cut off at the last band feeds every
+// band.
+//==============================================================
+template <class T>
+vector<vector<pair<double, double> > > WeightedGraph<T>::isochrones(pair<double, double> start, const vector<double>& bands) {
+    for (size_t i = 0; i < bands.size(); i++) {
+        if (!(bands[i] >= 0) || (i > 0 && bands[i] <= bands[i - 1])) {
+            throw invalid_argument("Isochrone bands must be non-negative and increasing");
+        }
+    }
 
-    while (!pq.isEmpty()) {
-        auto [current, currentDist] = pq.extractMin();
+    vector<vector<pair<double, double> > > groups(bands.size());
+    if (bands.empty()) {
+        return groups;
+    }
 
-        if (current == startAndEndNodes.second) {
-            break;
+    vector<double> distances;
+    vector<int> parents;
+    oneToAll(start, distances, parents, bands.back());
+    for (int u = 0; u < csr.numNodes(); u++) {
+        if (distances[u] <= bands.back()) {
+            int band = lower_bound(bands.begin(), bands.end(), distances[u]) - bands.begin();
+            groups[band].push_back(csr.coord(u));
         }
+    }
+    return groups;
+}
 
-        for (const auto& [neighbor, weight] : adjacencyList[current]) {
-            double newDist = currentDist + weight;
+//==============================================================
+// distanceMatrix
+// INPUTS: Start coordinates, end coordinates, number of threads
+//         (0 for one per core)
+// OUTPUTS: matrix[i][j] is the shortest distance from sources[i] to
+//          destinations[j], infinity if there is no path
+// Runs one search per distinct start node that stops once every
+// end node is settled, rather than one search per cell. Start
+// nodes are handed out to the threads one at a time, and each
+// thread searches with its own workspace.
+//==============================================================
+template <class T>
+vector<vector<double> > WeightedGraph<T>::distanceMatrix(const vector<pair<double, double> >& sources,
+                                                         const vector<pair<double, double> >& destinations, int threads) {
+    const CSRGraph<T>& g = freeze();
+    auto denseNode = [&](pair<double, double> coord) {
+        int u = g.locate(coord);
+        if (u == -1) {
+            throw invalid_argument("Start or end coord not found");
+        }
+        return u;
+    };
 
-            if (S[neighbor].second > newDist) {
-                S[neighbor].second = newDist;
-                S[neighbor].first = current;
+    vector<int> targetNodes(destinations.size());
+    for (size_t j = 0; j < destinations.size(); j++) {
+        targetNodes[j] = denseNode(destinations[j]);
+    }
+    vector<int> targetList(targetNodes);
+    sort(targetList.begin(), targetList.end());
+    targetList.erase(unique(targetList.begin(), targetList.end()), targetList.end());
+
+    // rows of repeated start nodes are copied from the first one
+    vector<int> sourceNodes(sources.size());
+    vector<int> searches;
+    unordered_map<int, int> firstRow;
+    for (size_t i = 0; i < sources.size(); i++) {
+        sourceNodes[i] = denseNode(sources[i]);
+        if (firstRow.emplace(sourceNodes[i], i).second) {
+            searches.push_back(i);
+        }
+    }
 
-                pq.decreaseKey(neighbor, newDist);
+    vector<vector<double> > matrix(sources.size(), vector<double>(destinations.size()));
+    atomic<size_t> next(0);
+    runParallel(min<int>(threadCount(threads), max<size_t>(searches.size(), 1)), [&](int) {
+        SearchWorkspace ws;
+        ws.queueType = workspace.queueType;
+        ws.dialQueue.setWidth(workspace.dialQueue.bucketWidth());
+        for (size_t k = next++; k < searches.size(); k = next++) {
+            int row = searches[k];
+            g.oneToMany(sourceNodes[row], targetList, ws);
+            for (size_t j = 0; j < destinations.size(); j++) {
+                matrix[row][j] = ws.distance(targetNodes[j]);
             }
         }
+    });
+    for (size_t i = 0; i < sources.size(); i++) {
+        int row = firstRow[sourceNodes[i]];
+        if (row != static_cast<int>(i)) {
+            matrix[i] = matrix[row];
+        }
+    }
+    return matrix;
+}
+
+//==============================================================
+// Bidirectional Dijkstra's
+// INPUTS: Start coordinate pair and end coordinate pair
+// OUTPUTS: Vector of shortest path coordinates
+// Same result as dijkstras(), but searches forward from the start
+// and backward from the end at the same time and stops once the
+// two searches prove no shorter path exists
+//==============================================================
+template <class T>
+vector<pair<double, double> > WeightedGraph<T>::bidirectionalDijkstras(pair<double, double> start, pair<double, double> end) {
+    pair<double, double> startAndEndNodes = findNode(start, end);
+    const CSRGraph<T>& g = freeze();
+
+    int source = g.denseId(startAndEndNodes.first);
+    int target = g.denseId(startAndEndNodes.second);
+
+    g.bidirectionalDijkstras(source, target, workspace, backwardWorkspace);
+    return pathCoords(workspace.path(target), target);
+}
+
+//==============================================================
+// A*
+// INPUTS: Start coordinate pair and end coordinate pair
+// OUTPUTS: Vector of shortest path coordinates
+// Same result as dijkstras(), but uses the vertex coordinates as a
+// lower bound on the remaining distance to steer the search. Falls
+// back to dijkstras() when the coordinates can't give a safe bound.
+// getSettled() reports how many nodes the search settled.
+//==============================================================
+template <class T>
+vector<pair<double, double> > WeightedGraph<T>::aStar(pair<double, double> start, pair<double, double> end) {
+    pair<double, double> startAndEndNodes = findNode(start, end);
+    const CSRGraph<T>& g = freeze();
+
+    int source = g.denseId(startAndEndNodes.first);
+    int target = g.denseId(startAndEndNodes.second);
+
+    g.aStar(source, target, workspace);
+    return pathCoords(workspace.path(target), target);
+}
+
+//==============================================================
+// Contraction Hierarchy Query
+// INPUTS: Start coordinate pair and end coordinate pair
+// OUTPUTS: Vector of shortest path coordinates
+// Same result as dijkstras(), answered from the contraction
+// hierarchy. The hierarchy is built by the first call after the
+// graph changes, which is slow; every later query is fast.
+//==============================================================
+template <class T>
+vector<pair<double, double> > WeightedGraph<T>::contractionHierarchyQuery(pair<double, double> start, pair<double, double> end) {
+    pair<double, double> startAndEndNodes = findNode(start, end);
+    const ContractionHierarchy<T>& ch = contract();
+
+    int source = csr.denseId(startAndEndNodes.first);
+    int target = csr.denseId(startAndEndNodes.second);
+
+    vector<int> densePath;
+    ch.query(source, target, workspace, backwardWorkspace, densePath);
+    return pathCoords(densePath, target);
+}
+
+//==============================================================
+// pathCoords
+// INPUTS: Dense nodes of a path found by a search, its target
+// OUTPUTS: Coordinates along the path. If the target was not
+//          reached the path only holds the target.
+//==============================================================
+template <class T>
+vector<pair<double, double> > WeightedGraph<T>::pathCoords(vector<int> densePath, int target) {
+    if (densePath.empty()) {
+        densePath.push_back(target);
     }
 
     vector<pair<double, double>> path;
-    for (T i = startAndEndNodes.second; i != -1; i = S[i].first) {
-        path.push_back(coords[i]);
+    for (int u : densePath) {
+        path.push_back(csr.coord(u));
     }
-    reverse(path.begin(), path.end());
 
     return path;    
 }
 
+//==============================================================
+// freeze
+// INPUTS: NONE
+// OUTPUTS: CSR copy of the graph
+// Rebuilds the CSR copy if the graph changed since the last
+// freeze, otherwise returns the existing one
+//==============================================================
+template <class T>
+const CSRGraph<T>& WeightedGraph<T>::freeze() {
+    if (!frozen) {
+        csr = CSRGraph<T>(coords, adjacencyList);
+        if (nodeOrder != ID_ORDER) {
+            csr = csr.reordered(nodeOrder);
+        }
+        frozen = true;
+    }
+    return csr;
+}
+
+//==============================================================
+// setQueueType
+// INPUTS: Queue for dijkstras() and distanceMatrix() to use, bucket
+//         width for DIAL_BUCKETS
+// OUTPUTS: NONE
+// RADIX_HEAP and DIAL_BUCKETS rely on distances only growing during
+// a search, so they throw on graphs with negative weights
+//==============================================================
+template <class T>
+void WeightedGraph<T>::setQueueType(QueueType type, double bucketWidth) {
+    workspace.dialQueue.setWidth(bucketWidth);
+    workspace.queueType = type;
+}
+
+//==============================================================
+// setRouteCacheSize
+// INPUTS: Most routes to keep, 0 to turn the cache off
+// OUTPUTS: NONE
+// Routes from dijkstras() and shortestRoute() are cached by their
+// start and end node IDs and reused until the graph is edited.
+// Hit and miss counts can be read from getRouteCache().
+//==============================================================
+template <class T>
+void WeightedGraph<T>::setRouteCacheSize(size_t routes) {
+    routeCache.setCapacity(routes);
+}
+
+//==============================================================
+// setNodeOrder
+// INPUTS: Node order for freeze() to use
+// OUTPUTS: NONE
+// Renumbers the dense indices of the frozen graph, now or on the
+// next freeze. Node IDs, coordinates and routes don't change, but
+// arrays indexed by dense index (oneToAll, freeze()) follow the
+// new order. A contraction hierarchy is rebuilt on next use.
+//==============================================================
+template <class T>
+void WeightedGraph<T>::setNodeOrder(NodeOrder order) {
+    nodeOrder = order;
+    if (frozen) {
+        csr = csr.reordered(order);
+        contracted = false;
+    }
+}
+
 //==============================================================
 // printAdjacencyList
 // INPUTS: NONE
@@ -224,6 +723,7 @@ vector<pair<double, double> > WeightedGraph<T>::dijkstras(pair<double, double> s
 //==============================================================
 template <class T>
 void WeightedGraph<T>::printAdjacencyList() const {
+    thaw();
     for (const auto& [node, neighbors] : adjacencyList) {
         cout << node << ": ";
         for (const auto& [neighbor, weight] : neighbors) {
@@ -237,17 +737,17 @@ void WeightedGraph<T>::printAdjacencyList() const {
 // idFromCoords
 // INPUTS: Coord pair
 // OUTPUTS: Node ID
-// finds and returns id of node by searching coodrs for coordinate pair
+// finds and returns id of node by looking the coordinate pair up
+// in the spatial index, -1 if no node sits at those coordinates
 //==============================================================
 template <class T>
 T WeightedGraph<T>::idFromCoords(pair<double, double> node) {
-    T nodeId = -1; // -1 does not exist as id in coords
-    for (const auto& [id, coord] : coords) {                          
-        if (node.first == coord.first && node.second == coord.second) {
-            nodeId = id;
-        }
+    const CSRGraph<T>& g = freeze();
+    int u = g.locate(node);
+    if (u == -1) {
+        return -1; // -1 does not exist as id in coords
     }
-    return nodeId;
+    return g.nodeId(u);
 }
 
 //==============================================================
@@ -258,16 +758,8 @@ T WeightedGraph<T>::idFromCoords(pair<double, double> node) {
 //==============================================================
 template <class T>
 pair<double, double> WeightedGraph<T>::findNode(pair<double, double> start, pair<double, double> end) {
-    T startNode = -1, endNode = - 1;
-    for (const auto& [id, coord] : coords) {                          
-        if (start.first == coord.first && start.second == coord.second) {
-            startNode = id;
-        }
-
-        if (end.first == coord.first && end.second == coord.second) {
-            endNode = id;
-        }
-    }
+    T startNode = idFromCoords(start);
+    T endNode = idFromCoords(end);
 
     if (startNode == -1 || endNode == -1) {
         throw invalid_argument("Start or end coord not found");
@@ -276,6 +768,39 @@ pair<double, double> WeightedGraph<T>::findNode(pair<double, double> start, pair
     return make_pair(startNode, endNode);
 }
 
+//==============================================================
+// nearestNode
+// INPUTS: Any coordinate pair
+// OUTPUTS: Coordinates of the closest vertex in the graph
+// Snaps an arbitrary coordinate to the nearest node so it can be
+// used as a start or end point
+//==============================================================
+template <class T>
+pair<double, double> WeightedGraph<T>::nearestNode(pair<double, double> coord) {
+    const CSRGraph<T>& g = freeze();
+    int u = g.nearest(coord);
+    if (u == -1) {
+        throw invalid_argument("Graph has no coordinates");
+    }
+    return g.coord(u);
+}
+
+//==============================================================
+// contract
+// INPUTS: NONE
+// OUTPUTS: Contraction hierarchy of the graph
+// Preprocesses the graph into a contraction hierarchy if it changed
+// since the last call, otherwise returns the existing one
+//==============================================================
+template <class T>
+const ContractionHierarchy<T>& WeightedGraph<T>::contract() {
+    if (!contracted) {
+        hierarchy = ContractionHierarchy<T>(freeze());
+        contracted = true;
+    }
+    return hierarchy;
+}
+
 // class instantiations
 template class WeightedGraph<long>;
 template class WeightedGraph<long long>;
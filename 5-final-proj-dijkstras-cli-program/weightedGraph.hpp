@@ -13,8 +13,20 @@
 #include <fstream>
 #include <sstream>
 #include <cmath>
+#include <limits>
 #include <algorithm>
+#include <atomic>
+#include <mutex>
 #include "priorityQueue.hpp"
+#include "csrGraph.hpp"
+#include "contractionHierarchy.hpp"
+#include "graphParser.hpp"
+#include "parallelLoader.hpp"
+#include "parallel.hpp"
+#include "route.hpp"
+#include "routeCache.hpp"
+#include "kShortestPaths.hpp"
+#include "deltaStepping.hpp"
 using namespace std;
 
 
@@ -23,9 +35,24 @@ using namespace std;
 template <typename T>
 class WeightedGraph {
     private:
-        unordered_map<T, pair<double, double> > coords;
-        unordered_map<T, unordered_map<T, double > > adjacencyList;
+        mutable unordered_map<T, pair<double, double> > coords;
+        mutable unordered_map<T, unordered_map<T, double > > adjacencyList;
 		int listSize;
+        CSRGraph<T> csr;    // frozen copy of the graph that searches run over
+        bool frozen;        // true while csr matches coords and adjacencyList
+        NodeOrder nodeOrder;    // how freeze() numbers the nodes of csr
+        SearchWorkspace workspace;  // reused by every dijkstras() call
+        SearchWorkspace backwardWorkspace;  // second side of bidirectional searches
+        ContractionHierarchy<T> hierarchy;  // built on first use by contract()
+        bool contracted;    // true while hierarchy matches the graph
+        mutable atomic<bool> thawed;    // false while a graph read from a binary file lives only in csr
+        mutable mutex thawLock;         // lets const readers fill the maps from csr once, safely
+        RouteCache<T> routeCache;   // routes by (start ID, end ID), off unless given a size
+
+        vector<pair<double, double> >   pathCoords(vector<int> densePath, int target);
+        double                          findRoute(int source, int target, SearchWorkspace& ws, Route<T>& route) const;
+        void                            thaw() const;
+        static  WeightedGraph<T>        parse(GraphParser& parser);
     public:
                                                 WeightedGraph();
                                                 WeightedGraph(const WeightedGraph<T> &other);
@@ -37,14 +64,42 @@ class WeightedGraph {
                 T                               idFromCoords(pair<double, double> node);
                 void                            addVertex(const T& id, double x, double y);
                 vector<pair <double, double> >  dijkstras(pair<double, double> startCoord, pair<double, double> endCoord);
+                double                          dijkstras(pair<double, double> startCoord, pair<double, double> endCoord,
+                                                          SearchWorkspace& ws, vector<pair<double, double> >& route);
+                double                          dijkstras(pair<double, double> startCoord, pair<double, double> endCoord,
+                                                          SearchWorkspace& ws, Route<T>& route);
+                Route<T>                        shortestRoute(pair<double, double> startCoord, pair<double, double> endCoord);
+                vector<Route<T> >               kShortestPaths(pair<double, double> startCoord, pair<double, double> endCoord,
+                                                               int k, int threads = 0);
+                vector<pair <double, double> >  bidirectionalDijkstras(pair<double, double> startCoord, pair<double, double> endCoord);
+                int                             oneToAll(pair<double, double> startCoord, vector<double>& distances, vector<int>& parents,
+                                                         double cutoff = numeric_limits<double>::infinity());
+                int                             parallelOneToAll(pair<double, double> startCoord, vector<double>& distances,
+                                                                 double delta = 0, int threads = 0);
+                vector<vector<pair<double, double> > > isochrones(pair<double, double> startCoord, const vector<double>& bands);
+                vector<vector<double> >         distanceMatrix(const vector<pair<double, double> >& sources,
+                                                               const vector<pair<double, double> >& destinations, int threads = 0);
+                vector<pair <double, double> >  aStar(pair<double, double> startCoord, pair<double, double> endCoord);
         static  WeightedGraph<T>                readFromSTDIN();
         static  WeightedGraph<T>                readFromFile(const string& filename);
+        static  WeightedGraph<T>                readFromFileParallel(const string& filename, int threads = 0);
+        static  WeightedGraph<T>                readFromBinary(const string& filename, bool verify = true);
+                void                            writeBinary(const string& filename);
                 pair<double, double>            findNode(pair<double, double> start, pair<double, double> end);
+                pair<double, double>            nearestNode(pair<double, double> coord);
+                void                            setQueueType(QueueType type, double bucketWidth = 1.0);
+                void                            setRouteCacheSize(size_t routes);
+                void                            setNodeOrder(NodeOrder order);
+                const CSRGraph<T>&              freeze();
+                const ContractionHierarchy<T>&  contract();
+                vector<pair <double, double> >  contractionHierarchyQuery(pair<double, double> startCoord, pair<double, double> endCoord);
 
         // getter functions
-        const   auto&                           getCoords() const { return coords; }
-        unordered_map<T, unordered_map<T, double > > getAdjacencyList() const { return adjacencyList; }
+        const   unordered_map<T, pair<double, double> >& getCoords() const { thaw(); return coords; }
+        const   unordered_map<T, unordered_map<T, double > >& getAdjacencyList() const { thaw(); return adjacencyList; }
                 int                             getSize() const { return listSize; }
+                int                             getSettled() const { return workspace.settled; }
+        const   RouteCache<T>&                  getRouteCache() const { return routeCache; }
 };
 
 #endif
\ No newline at end of file